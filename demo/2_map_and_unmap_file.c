@@ -1,27 +1,45 @@
 #include <stdio.h>
+#include <string.h>
 
-#define TRACE_ERROR(error) printf("[ERROR] %s\n", (error))
+#define TRACE_ERROR(error) fprintf(stderr, "[ERROR] %s\n", (error))
 // #define LARGE_PAGES
 
 #define OS_IMPLEMENTATION
 #include "../os.h"
 
-void MapAndUnmapFile(const char *filePath) {
+#define KB(N) ((N)*1024)
+
+void MapAndUnmapFile(Writer *writer, const char *filePath) {
     Bytes fileMap;
     if (!MapFile(filePath, &fileMap)) {
-        printf("[ERROR] Could not map file `%s` into memory\n", filePath);
+        fprintf(stderr, "[ERROR] Could not map file `%s` into memory\n", filePath);
         return;
     }
 
-    printf("%s:\n%s", filePath, (char*) fileMap.base);
+    Bytes name = {(Uint8*) filePath, strlen(filePath)};
+    Bytes separator = {(Uint8*) ":\n", 2};
+    if (!WriteBytes(writer, name) || !WriteBytes(writer, separator) || !WriteBytes(writer, fileMap)) {
+        fprintf(stderr, "[ERROR] Could not write file `%s`\n", filePath);
+    }
 
     if (!UnmapFile(fileMap)) {
-        printf("[ERROR] Could not unmap file `%s` from memory\n", filePath);
+        fprintf(stderr, "[ERROR] Could not unmap file `%s` from memory\n", filePath);
         return;
     }
 }
 
 void main() {
-    MapAndUnmapFile("./demo/lorem_ipsum");
-    MapAndUnmapFile("./demo/empty_file");
+    Writer writer;
+    if (!OpenStdoutWriter(KB(64), &writer)) {
+        fprintf(stderr, "[ERROR] Could not open a writer for stdout\n");
+        return;
+    }
+
+    MapAndUnmapFile(&writer, "./demo/lorem_ipsum");
+    MapAndUnmapFile(&writer, "./demo/empty_file");
+
+    if (!CloseWriter(&writer)) {
+        fprintf(stderr, "[ERROR] Could not close the writer for stdout\n");
+        return;
+    }
 }
@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <pthread.h>
+
+#define TRACE_ERROR(error) fprintf(stderr, "[ERROR] %s\n", (error))
+
+#define OS_IMPLEMENTATION
+#include "../os.h"
+
+#define WRITER_COUNT 8
+#define READER_COUNT 4
+#define KEY_COUNT 200000
+#define ROUND_COUNT 4
+
+// Writers own every WRITER_COUNT-th key and overwrite it ROUND_COUNT times, so
+// the map starts tiny and grows many times while readers probe it. A reader
+// must never see a key vanish once seen, nor its round go backwards.
+static ConcurrentMap map;
+static volatile Uint64 stop;
+static volatile Uint64 errors;
+
+void *WriteKeys(void *argument) {
+    Uint64 writer = (Uint64) (size_t) argument;
+    for (Uint64 round = 1; round <= ROUND_COUNT; ++round) {
+        for (Uint64 key = writer; key < KEY_COUNT; key += WRITER_COUNT) {
+            if (!ConcurrentMapPut(&map, key + 1, key * 16 + round)) {
+                AtomicAdd64(&errors, 1);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void *ReadKeys(void *argument) {
+    static Uint8 lastRounds[READER_COUNT][KEY_COUNT];
+    Uint8 *lastRound = lastRounds[(size_t) argument];
+
+    Uint64 state = (Uint64) (size_t) argument * 7919 + 1;
+    while (!AtomicLoad64(&stop)) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        Uint64 key = state % KEY_COUNT;
+
+        Uint64 value;
+        if (!ConcurrentMapGet(&map, key + 1, &value)) {
+            if (lastRound[key] != 0) {
+                AtomicAdd64(&errors, 1);
+            }
+            continue;
+        }
+        if (value / 16 != key || value % 16 < lastRound[key]) {
+            AtomicAdd64(&errors, 1);
+        }
+        lastRound[key] = (Uint8) (value % 16);
+    }
+
+    return NULL;
+}
+
+void main() {
+    if (!InitConcurrentMap(16, &map)) {
+        fprintf(stderr, "[ERROR] Could not init the concurrent map\n");
+        return;
+    }
+
+    pthread_t readers[READER_COUNT];
+    pthread_t writers[WRITER_COUNT];
+    for (Uint64 i = 0; i < READER_COUNT; ++i) {
+        pthread_create(&readers[i], NULL, ReadKeys, (void*) (size_t) i);
+    }
+    for (Uint64 i = 0; i < WRITER_COUNT; ++i) {
+        pthread_create(&writers[i], NULL, WriteKeys, (void*) (size_t) i);
+    }
+
+    for (Uint64 i = 0; i < WRITER_COUNT; ++i) {
+        pthread_join(writers[i], NULL);
+    }
+    AtomicStore64(&stop, 1);
+    for (Uint64 i = 0; i < READER_COUNT; ++i) {
+        pthread_join(readers[i], NULL);
+    }
+
+    for (Uint64 key = 0; key < KEY_COUNT; ++key) {
+        Uint64 value;
+        if (!ConcurrentMapGet(&map, key + 1, &value) || value != key * 16 + ROUND_COUNT) {
+            errors++;
+        }
+    }
+
+    printf("keys=%d writers=%d readers=%d errors=%llu\n", KEY_COUNT, WRITER_COUNT, READER_COUNT, errors);
+
+    if (!ReleaseConcurrentMap(&map)) {
+        fprintf(stderr, "[ERROR] Could not release the concurrent map\n");
+        return;
+    }
+}
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <pthread.h>
+
+#define TRACE_ERROR(error) fprintf(stderr, "[ERROR] %s\n", (error))
+
+#define OS_IMPLEMENTATION
+#include "../os.h"
+
+#define MB(N) ((N)*1024*1024)
+
+#define WRITER_COUNT 8
+#define READER_COUNT 2
+#define INSERT_COUNT 100000
+#define KEY_RANGE (INSERT_COUNT * 4)
+
+// Writers insert random keys, repeats included, whose value starts with the
+// key itself. Readers scan the whole list meanwhile and check that keys come
+// out in order and that every value belongs to its key.
+static Arena arena;
+static SkipList skipList;
+static volatile Uint64 stop;
+static volatile Uint64 errors;
+
+void *InsertKeys(void *argument) {
+    Uint64 state = (Uint64) (size_t) argument * 977 + 3;
+    for (Uint64 i = 0; i < INSERT_COUNT; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        Uint64 value[2] = {state % KEY_RANGE, (Uint64) (size_t) argument};
+        Bytes bytes = {(Uint8*) value, sizeof(value)};
+        if (!SkipListInsert(&skipList, value[0], bytes)) {
+            AtomicAdd64(&errors, 1);
+        }
+    }
+
+    return NULL;
+}
+
+Uint64 CheckOrder(void) {
+    Uint64 count = 0;
+    Uint64 previous = 0;
+    Uint64 cursor = 0;
+    Uint64 key;
+    Bytes value;
+    while (SkipListNext(&skipList, &cursor, &key, &value)) {
+        if (key < previous || value.size != 2 * sizeof(Uint64) || ((Uint64*) value.base)[0] != key) {
+            AtomicAdd64(&errors, 1);
+        }
+        previous = key;
+        count++;
+    }
+
+    return count;
+}
+
+void *ScanKeys(void *argument) {
+    while (!AtomicLoad64(&stop)) {
+        CheckOrder();
+    }
+
+    return NULL;
+}
+
+void main() {
+    if (!InitArena(MB(256), &arena) || !InitSkipList(&arena, &skipList)) {
+        fprintf(stderr, "[ERROR] Could not init the skip list\n");
+        return;
+    }
+
+    pthread_t readers[READER_COUNT];
+    pthread_t writers[WRITER_COUNT];
+    for (Uint64 i = 0; i < READER_COUNT; ++i) {
+        pthread_create(&readers[i], NULL, ScanKeys, NULL);
+    }
+    for (Uint64 i = 0; i < WRITER_COUNT; ++i) {
+        pthread_create(&writers[i], NULL, InsertKeys, (void*) (size_t) i);
+    }
+
+    for (Uint64 i = 0; i < WRITER_COUNT; ++i) {
+        pthread_join(writers[i], NULL);
+    }
+    AtomicStore64(&stop, 1);
+    for (Uint64 i = 0; i < READER_COUNT; ++i) {
+        pthread_join(readers[i], NULL);
+    }
+
+    Uint64 count = CheckOrder();
+    if (count != WRITER_COUNT * INSERT_COUNT) {
+        errors++;
+    }
+
+    Uint64 found = 0;
+    for (Uint64 key = 0; key < KEY_RANGE; ++key) {
+        Bytes value;
+        if (SkipListFind(&skipList, key, &value)) {
+            found++;
+        }
+    }
+
+    Uint64 cursor;
+    Uint64 key;
+    Bytes value;
+    SkipListSeek(&skipList, KEY_RANGE / 2, &cursor);
+    if (SkipListNext(&skipList, &cursor, &key, &value) && key < KEY_RANGE / 2) {
+        errors++;
+    }
+
+    printf("nodes=%llu distinct=%llu height=%llu errors=%llu\n", count, found, skipList.height, errors);
+
+    if (!ReleaseArena(&arena)) {
+        fprintf(stderr, "[ERROR] Could not release the arena\n");
+        return;
+    }
+}
@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_ERROR(error) fprintf(stderr, "[ERROR] %s\n", (error))
+
+#define OS_IMPLEMENTATION
+#include "../os.h"
+
+#define MB(N) ((N)*1024*1024)
+
+#define VALUE_COUNT 1000000
+
+void ParseLine(const char *line) {
+    printf("\"");
+    for (const char *c = line; *c != '\0'; ++c) {
+        printf(*c == '\r' ? "\\r" : "%c", *c);
+    }
+    printf("\" ->");
+
+    Bytes bytes = {(Uint8*) line, strlen(line)};
+    Int64 values[8];
+    Uint64 count;
+    if (!ParseInt64s(bytes, ',', values, 8, &count)) {
+        printf(" rejected\n");
+        return;
+    }
+
+    for (Uint64 i = 0; i < count; ++i) {
+        printf(" %lld", values[i]);
+    }
+    printf("\n");
+}
+
+Uint64 NextRandom(Uint64 *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// Writes random integers and random doubles at random precisions with printf,
+// parses them back in one call each and compares against the C library.
+void ParseRandomFields(void) {
+    Bytes text;
+    Bytes numbers;
+    if (!Alloc(MB(32), &text) || !Alloc(VALUE_COUNT * 2 * sizeof(Uint64), &numbers)) {
+        fprintf(stderr, "[ERROR] Could not allocate buffers\n");
+        return;
+    }
+
+    Int64 *expectedInts = (Int64*) numbers.base;
+    Int64 *parsedInts = expectedInts + VALUE_COUNT;
+    Uint64 state = 88172645463325252ull;
+    Uint64 size = 0;
+    for (Uint64 i = 0; i < VALUE_COUNT; ++i) {
+        Uint64 shift = NextRandom(&state) % 64;
+        expectedInts[i] = (Int64) (NextRandom(&state) >> shift);
+        size += snprintf((char*) text.base + size, text.size - size, "%lld,", expectedInts[i]);
+    }
+
+    Uint64 count;
+    Uint64 intErrors = 0;
+    Bytes bytes = {text.base, size};
+    if (!ParseInt64s(bytes, ',', parsedInts, VALUE_COUNT, &count) || count != VALUE_COUNT) {
+        intErrors = VALUE_COUNT;
+    } else {
+        for (Uint64 i = 0; i < VALUE_COUNT; ++i) {
+            intErrors += parsedInts[i] != expectedInts[i];
+        }
+    }
+
+    Float64 *parsedFloats = (Float64*) numbers.base;
+    Uint64 *offsets = (Uint64*) numbers.base + VALUE_COUNT;
+    size = 0;
+    for (Uint64 i = 0; i < VALUE_COUNT; ++i) {
+        Float64 value;
+        do {
+            Uint64 bits = NextRandom(&state);
+            memcpy(&value, &bits, sizeof(value));
+        } while (value != value || value - value != 0);
+
+        offsets[i] = size;
+        int precision = 1 + (int) (NextRandom(&state) % 17);
+        size += snprintf((char*) text.base + size, text.size - size, "%.*g\r\n", precision, value);
+    }
+
+    Uint64 floatErrors = 0;
+    bytes.size = size;
+    if (!ParseFloat64s(bytes, '\n', parsedFloats, VALUE_COUNT, &count) || count != VALUE_COUNT) {
+        floatErrors = VALUE_COUNT;
+    } else {
+        for (Uint64 i = 0; i < VALUE_COUNT; ++i) {
+            Float64 expected = strtod((char*) text.base + offsets[i], NULL);
+            floatErrors += memcmp(&parsedFloats[i], &expected, sizeof(expected)) != 0;
+        }
+    }
+
+    printf("ints=%d errors=%llu floats=%d errors=%llu\n", VALUE_COUNT, intErrors, VALUE_COUNT, floatErrors);
+
+    if (!Free(text) || !Free(numbers)) {
+        fprintf(stderr, "[ERROR] Could not free buffers\n");
+        return;
+    }
+}
+
+void main() {
+    ParseLine("1,-2,3");
+    ParseLine("1,-2,3,");
+    ParseLine("1\r");
+    ParseLine("1,,3");
+    ParseLine(",");
+    ParseLine("");
+    ParseLine("9223372036854775808");
+
+    ParseRandomFields();
+}
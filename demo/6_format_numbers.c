@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_ERROR(error) fprintf(stderr, "[ERROR] %s\n", (error))
+
+#define OS_IMPLEMENTATION
+#include "../os.h"
+
+#define VALUE_COUNT 100000
+
+void FormatValue(Float64 value) {
+    Uint8 text[32];
+    Bytes buffer = {text, sizeof(text)};
+    Uint64 length;
+    if (!FormatFloat64(value, buffer, &length)) {
+        fprintf(stderr, "[ERROR] Could not format `%g`\n", value);
+        return;
+    }
+
+    printf("%-24.17g -> %.*s\n", value, (int) length, text);
+}
+
+Uint64 NextRandom(Uint64 *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// Counts the significant digits of a formatted float, skipping the sign, the
+// point, the exponent and any zeros padding the digits on either side.
+Uint64 CountSignificantDigits(const Uint8 *text, Uint64 length) {
+    Uint64 first = 0;
+    Uint64 last = 0;
+    Uint64 position = 0;
+    for (Uint64 i = 0; i < length && text[i] != 'e'; ++i) {
+        if (text[i] < '0' || text[i] > '9') {
+            continue;
+        }
+        position++;
+        if (text[i] != '0') {
+            first = first == 0 ? position : first;
+            last = position;
+        }
+    }
+
+    return first == 0 ? 1 : last - first + 1;
+}
+
+// Formats random finite doubles and checks that each parses back to the same
+// bits and that no shorter decimal printed by printf would have done so.
+void FormatRandomValues(void) {
+    Uint64 state = 88172645463325252ull;
+    Uint64 roundTripErrors = 0;
+    Uint64 lengthErrors = 0;
+    for (Uint64 i = 0; i < VALUE_COUNT; ++i) {
+        Float64 value;
+        do {
+            Uint64 bits = NextRandom(&state);
+            memcpy(&value, &bits, sizeof(value));
+        } while (value != value || value - value != 0);
+
+        Uint8 text[32];
+        Bytes buffer = {text, sizeof(text)};
+        Uint64 length;
+        if (!FormatFloat64(value, buffer, &length)) {
+            roundTripErrors++;
+            continue;
+        }
+        text[length] = '\0';
+
+        Float64 parsed = strtod((char*) text, NULL);
+        roundTripErrors += memcmp(&parsed, &value, sizeof(value)) != 0;
+
+        int precision = 1;
+        for (; precision < 17; ++precision) {
+            char shorter[32];
+            snprintf(shorter, sizeof(shorter), "%.*e", precision - 1, value);
+            if (strtod(shorter, NULL) == value) {
+                break;
+            }
+        }
+        lengthErrors += CountSignificantDigits(text, length) != (Uint64) precision;
+    }
+
+    Uint64 intErrors = 0;
+    for (Uint64 i = 0; i < VALUE_COUNT; ++i) {
+        Uint64 shift = NextRandom(&state) % 64;
+        Int64 value = (Int64) (NextRandom(&state) >> shift);
+        Uint8 text[32];
+        Bytes buffer = {text, sizeof(text)};
+        Uint64 length;
+        char expected[32];
+        int expectedLength = snprintf(expected, sizeof(expected), "%lld", value);
+        if (!FormatInt64(value, buffer, &length) || length != (Uint64) expectedLength || memcmp(text, expected, length) != 0) {
+            intErrors++;
+        }
+    }
+
+    printf("floats=%d round trip errors=%llu length errors=%llu ints=%d errors=%llu\n",
+           VALUE_COUNT, roundTripErrors, lengthErrors, VALUE_COUNT, intErrors);
+}
+
+void main() {
+    FormatValue(0.1);
+    FormatValue(-2.5);
+    FormatValue(1e23);
+    FormatValue(123456789012345678.0);
+    FormatValue(0.00001);
+    FormatValue(5e-324);
+    FormatValue(1.7976931348623157e308);
+    FormatValue(-0.0);
+    FormatValue(strtod("inf", NULL));
+    FormatValue(strtod("nan", NULL));
+
+    Uint8 text[32];
+    Bytes buffer = {text, sizeof(text)};
+    Uint64 length;
+    if (FormatTimestamp(1700000000, buffer, &length)) {
+        printf("%-24d -> %.*s\n", 1700000000, (int) length, text);
+    }
+
+    FormatRandomValues();
+}
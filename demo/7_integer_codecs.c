@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_ERROR(error) fprintf(stderr, "[ERROR] %s\n", (error))
+
+#define OS_IMPLEMENTATION
+#include "../os.h"
+
+#define VALUE_COUNT 1000000
+#define BLOCK_COUNT 100000
+
+Uint64 NextRandom(Uint64 *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// Delta encodes a sorted list with gaps of random magnitude, compresses the
+// gaps with Stream VByte and checks that decoding restores the list.
+void RoundTripStreamVByte(Uint32 *values, Uint32 *decoded, Bytes buffer) {
+    Uint64 state = 88172645463325252ull;
+    Uint32 value = 0;
+    for (Uint64 i = 0; i < VALUE_COUNT; ++i) {
+        Uint64 shift = 40 + NextRandom(&state) % 24;
+        value += (Uint32) (NextRandom(&state) >> shift);
+        values[i] = value;
+    }
+
+    memcpy(decoded, values, VALUE_COUNT * sizeof(Uint32));
+    EncodeDelta(decoded, VALUE_COUNT);
+
+    Uint64 length;
+    if (!EncodeStreamVByte(decoded, VALUE_COUNT, buffer, &length)) {
+        fprintf(stderr, "[ERROR] Could not encode values with Stream VByte\n");
+        return;
+    }
+
+    Bytes encoded = {buffer.base, length};
+    if (!DecodeStreamVByte(encoded, VALUE_COUNT, decoded)) {
+        fprintf(stderr, "[ERROR] Could not decode values with Stream VByte\n");
+        return;
+    }
+    DecodeDelta(decoded, VALUE_COUNT);
+
+    Uint64 errors = 0;
+    for (Uint64 i = 0; i < VALUE_COUNT; ++i) {
+        errors += decoded[i] != values[i];
+    }
+
+    printf("stream vbyte values=%d bytes=%llu errors=%llu\n", VALUE_COUNT, length, errors);
+}
+
+// Packs blocks of random length at every bit width against a random reference,
+// so that both the wide kernels and the byte-wise tail see every width.
+void RoundTripPackBits(Uint32 *values, Uint32 *decoded, Bytes buffer) {
+    Uint64 state = 2463534242ull;
+    Uint64 errors = 0;
+    Uint64 packed = 0;
+    for (Uint64 block = 0; block < BLOCK_COUNT; ++block) {
+        Uint32 bitWidth = (Uint32) (block % 33);
+        Uint64 count = NextRandom(&state) % 300;
+        Uint32 reference = (Uint32) NextRandom(&state);
+        Uint64 mask = (1ull << bitWidth) - 1;
+        for (Uint64 i = 0; i < count; ++i) {
+            values[i] = reference + (Uint32) (NextRandom(&state) & mask);
+        }
+
+        Uint64 length;
+        if (!PackBits(values, count, reference, bitWidth, buffer, &length)) {
+            errors++;
+            continue;
+        }
+
+        Bytes bytes = {buffer.base, length};
+        if (!UnpackBits(bytes, count, reference, bitWidth, decoded)) {
+            errors++;
+            continue;
+        }
+
+        for (Uint64 i = 0; i < count; ++i) {
+            errors += decoded[i] != values[i];
+        }
+        packed += count;
+    }
+
+    printf("pack bits blocks=%d values=%llu errors=%llu\n", BLOCK_COUNT, packed, errors);
+}
+
+void main() {
+    Bytes values;
+    Bytes decoded;
+    Bytes buffer;
+    if (!Alloc(VALUE_COUNT * sizeof(Uint32), &values) || !Alloc(VALUE_COUNT * sizeof(Uint32), &decoded) ||
+        !Alloc(StreamVByteSize(VALUE_COUNT), &buffer)) {
+        fprintf(stderr, "[ERROR] Could not allocate buffers\n");
+        return;
+    }
+
+    printf("cpu features=0x%x\n", CpuFeatures());
+    RoundTripStreamVByte((Uint32*) values.base, (Uint32*) decoded.base, buffer);
+    RoundTripPackBits((Uint32*) values.base, (Uint32*) decoded.base, buffer);
+
+    if (!Free(values) || !Free(decoded) || !Free(buffer)) {
+        fprintf(stderr, "[ERROR] Could not free buffers\n");
+        return;
+    }
+}
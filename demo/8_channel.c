@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define TRACE_ERROR(error) fprintf(stderr, "[ERROR] %s\n", (error))
+
+#define OS_IMPLEMENTATION
+#include "../os.h"
+
+#define KB(N) ((N)*1024)
+
+#define FRAME_COUNT 2000000
+
+// Frame i holds (i * 7) % 300 bytes counting up from i, so sizes wrap around
+// the small ring at every alignment, including empty frames and skip markers.
+Uint64 FrameSize(Uint64 frame) {
+    return (frame * 7) % 300;
+}
+
+void ReadFrames(Bytes shared) {
+    Channel channel;
+    if (!OpenChannel(shared, &channel)) {
+        fprintf(stderr, "[ERROR] Could not open the channel\n");
+        return;
+    }
+
+    Uint64 errors = 0;
+    for (Uint64 i = 0; i < FRAME_COUNT; ++i) {
+        Bytes frame;
+        if (!ChannelPeek(&channel, &frame)) {
+            errors++;
+            break;
+        }
+
+        if (frame.size != FrameSize(i)) {
+            errors++;
+        }
+        for (Uint64 k = 0; k < frame.size; ++k) {
+            if (frame.base[k] != (Uint8) (i + k)) {
+                errors++;
+                break;
+            }
+        }
+
+        ChannelRelease(&channel, frame);
+    }
+
+    Bytes frame;
+    if (!ChannelPoll(&channel, &frame) || frame.base != NULL) {
+        errors++;
+    }
+
+    printf("reader frames=%d errors=%llu\n", FRAME_COUNT, errors);
+}
+
+void main() {
+    Bytes shared;
+    if (!AllocShared(KB(4), &shared)) {
+        fprintf(stderr, "[ERROR] Could not allocate shared memory\n");
+        return;
+    }
+
+    Channel channel;
+    if (!InitChannel(shared, &channel)) {
+        fprintf(stderr, "[ERROR] Could not init the channel\n");
+        return;
+    }
+
+    pid_t reader = fork();
+    if (reader == -1) {
+        fprintf(stderr, "[ERROR] Could not fork the reader\n");
+        return;
+    }
+    if (reader == 0) {
+        ReadFrames(shared);
+        fflush(stdout);
+        _exit(0);
+    }
+
+    for (Uint64 i = 0; i < FRAME_COUNT; ++i) {
+        Bytes frame;
+        if (!ChannelReserve(&channel, FrameSize(i), &frame)) {
+            fprintf(stderr, "[ERROR] Could not reserve frame `%llu`\n", i);
+            break;
+        }
+
+        for (Uint64 k = 0; k < frame.size; ++k) {
+            frame.base[k] = (Uint8) (i + k);
+        }
+        ChannelCommit(&channel, frame);
+    }
+
+    waitpid(reader, NULL, 0);
+    printf("writer frames=%d capacity=%llu\n", FRAME_COUNT, channel.capacity);
+
+    if (!UnmapFile(shared)) {
+        fprintf(stderr, "[ERROR] Could not free shared memory\n");
+        return;
+    }
+}
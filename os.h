@@ -14,21 +14,198 @@
 //  - Uint16
 //  - Uint32
 //  - Uint64
+//  - Float32
+//  - Float64
 //  - Bytes
+//  - Writer
+//  - Pool
+//  - Arena
+//  - SlotMap
+//  - ConcurrentMap
+//  - SkipList
+//  - SharedMutex
+//  - SharedCondition
+//  - SharedRwLock
+//  - Channel
+//  - Snapshot
+//
+// C++ types (C++17 and later)
+//  - AllocResource                                             - std::pmr::memory_resource backed by Alloc.
+//  - ArenaResource                                             - std::pmr::memory_resource backed by an Arena.
+//  - PoolResource                                              - std::pmr::memory_resource backed by a Pool.
+//  - ScopedBytes                                               - move-only owner that frees its Bytes.
+//  - ScopedFileMap                                             - move-only owner that unmaps its file map.
+//  - ArrayView<T>                                              - read-only view of count elements of T.
+//  - MappedArray<T>                                            - file mapped as an array of T, see MapFileArray.
+//  - Columns<Fields...>                                        - one column per field type, see AllocColumns, with
+//                                                                Scatter and Gather to convert from and to row structs.
 //
 // Macros
 //  - NDEBUG                                                    - when defined, assertions are disabled.
 //  - STATIC_ASSERT
+//  - CACHE_LINE_SIZE
+//  - PREFETCH(address)                                         - hint that address will be read soon.
+//  - ADVISE_NORMAL                                             - no particular access pattern.
+//  - ADVISE_RANDOM                                             - bytes will be read in random order.
+//  - ADVISE_SEQUENTIAL                                         - bytes will be read in ascending order.
+//  - ADVISE_WILL_NEED                                          - bytes will be read soon, start reading them in.
+//  - CPU_SSE2, CPU_SSSE3, CPU_SSE41, CPU_AVX2, CPU_AVX512F, CPU_AVX512BW
+//                                                              - flags returned by CpuFeatures.
 //  - TRACE_ERROR                                               - called with a human readable message when an error occurs.
 //  - TRUE
 //  - FALSE
 //  - LARGE_PAGES                                               - when defined, allocations will use large pages.
+//  - STATIC_ARENA_SIZE                                         - when defined, allocations are served from this many bytes
+//                                                                of static memory before falling back to the system;
+//                                                                those under 4096 bytes are only cache line aligned.
 //
 // Functions
-//  - Bool Alloc(Uint64 size, Bytes *bytes)                     - alloc size bytes of read-write memory.
+//  - Bool Alloc(Uint64 size, Bytes *bytes)                     - alloc size bytes of zeroed read-write memory, page aligned.
 //  - Bool Free(Bytes bytes)                                    - free bytes.
 //  - Bool MapFile(const char *filePath, String *fileMap)       - map a file into readonly memory.
 //  - Bool UnmapFile(String fileMap)                            - unmap a file from memory.
+//  - Bool MapFileRange(const char *filePath, Uint64 offset, Uint64 size, Bytes *fileMap)
+//                                                              - map size bytes of a file at offset into readonly memory.
+//  - Bool ParseUint64(Bytes bytes, Uint64 *value)              - parse bytes as a decimal unsigned integer.
+//  - Bool ParseInt64(Bytes bytes, Int64 *value)                - parse bytes as a decimal signed integer.
+//  - Bool ParseFloat64(Bytes bytes, Float64 *value)            - parse bytes as a decimal floating-point number.
+//  - Bool ParseInt64s(Bytes bytes, Uint8 delimiter, Int64 *values, Uint64 capacity, Uint64 *count)
+//                                                              - parse delimiter separated signed integers, ignoring a final
+//                                                                delimiter and a '\r' ending each field.
+//  - Bool ParseFloat64s(Bytes bytes, Uint8 delimiter, Float64 *values, Uint64 capacity, Uint64 *count)
+//                                                              - parse delimiter separated floating-point numbers, ignoring a final
+//                                                                delimiter and a '\r' ending each field.
+//  - Bool FormatUint64(Uint64 value, Bytes buffer, Uint64 *length)
+//                                                              - write value as a decimal unsigned integer.
+//  - Bool FormatInt64(Int64 value, Bytes buffer, Uint64 *length)
+//                                                              - write value as a decimal signed integer.
+//  - Bool FormatFloat64(Float64 value, Bytes buffer, Uint64 *length)
+//                                                              - write the shortest decimal that parses back to value.
+//  - Bool FormatTimestamp(Int64 unixSeconds, Bytes buffer, Uint64 *length)
+//                                                              - write an ISO-8601 UTC timestamp.
+//  - Bool OpenStdoutWriter(Uint64 size, Writer *writer)       - buffer writes to stdout in size bytes of memory.
+//  - Bool WriteBytes(Writer *writer, Bytes bytes)              - write bytes through writer.
+//  - Bool FlushWriter(Writer *writer)                          - write any buffered bytes.
+//  - Bool CloseWriter(Writer *writer)                          - flush writer and free its buffer.
+//  - void EncodeDelta(Uint32 *values, Uint64 count)           - replace sorted values with their gaps.
+//  - void DecodeDelta(Uint32 *values, Uint64 count)           - replace gaps with the running sum.
+//  - Uint64 StreamVByteSize(Uint64 count)                      - maximum encoded size of count values.
+//  - Bool EncodeStreamVByte(const Uint32 *values, Uint64 count, Bytes buffer, Uint64 *length)
+//                                                              - encode values with Stream VByte.
+//  - Bool DecodeStreamVByte(Bytes bytes, Uint64 count, Uint32 *values)
+//                                                              - decode count Stream VByte values.
+//  - Uint32 BitWidth(const Uint32 *values, Uint64 count, Uint32 reference)
+//                                                              - bits needed for values minus reference.
+//  - Bool PackBits(const Uint32 *values, Uint64 count, Uint32 reference, Uint32 bitWidth, Bytes buffer, Uint64 *length)
+//                                                              - frame-of-reference bit-pack values that fit bitWidth.
+//  - Bool UnpackBits(Bytes bytes, Uint64 count, Uint32 reference, Uint32 bitWidth, Uint32 *values)
+//                                                              - unpack count bit-packed values.
+//  - Uint64 IntersectSorted(const Uint32 *a, Uint64 aCount, const Uint32 *b, Uint64 bCount, Uint32 *out)
+//                                                              - write values in both sorted sets, return their count.
+//  - Uint64 UnionSorted(const Uint32 *a, Uint64 aCount, const Uint32 *b, Uint64 bCount, Uint32 *out)
+//                                                              - write values in either sorted set, return their count.
+//  - Uint64 DifferenceSorted(const Uint32 *a, Uint64 aCount, const Uint32 *b, Uint64 bCount, Uint32 *out)
+//                                                              - write values in a but not b, return their count.
+//  - Uint64 IntersectSortedMany(const Uint32 *const *lists, const Uint64 *counts, Uint64 listCount, Uint32 *out)
+//                                                              - write values in every sorted set, return their count.
+//  - Bool MapFileWritable(const char *filePath, Uint64 size, Bytes *fileMap)
+//                                                              - map a file of at least size bytes into read-write memory.
+//  - Bool GrowFileMap(const char *filePath, Uint64 size, Bytes *fileMap)
+//                                                              - grow a writable file map to at least size bytes.
+//  - Bool FlushFileMap(Bytes bytes)                            - write modified bytes of a writable file map back to disk; on
+//                                                                Windows only to the file system, not durably.
+//  - Bool AppendFile(const char *filePath, Bytes bytes, Bool sync)
+//                                                              - append bytes to a file, waiting for the disk when sync.
+//  - Bool InitPool(Uint64 blockSize, Uint64 blocksPerChunk, Pool *pool)
+//                                                              - prepare a pool of fixed size 8-byte aligned blocks.
+//  - Bool PoolAlloc(Pool *pool, Bytes *bytes)                  - take a block from the pool, its contents are undefined.
+//  - void PoolFree(Pool *pool, Bytes bytes)                    - return a block to the pool.
+//  - Bool ReleasePool(Pool *pool)                              - free every chunk of the pool.
+//  - Bool InitArena(Uint64 size, Arena *arena)                 - reserve size bytes for bump allocation.
+//  - Bool ArenaAlloc(Arena *arena, Uint64 size, Uint64 alignment, Bytes *bytes)
+//                                                              - take size bytes aligned to a power of two alignment.
+//  - Bool ArenaAllocConcurrent(Arena *arena, Uint64 size, Uint64 alignment, Bytes *bytes)
+//                                                              - ArenaAlloc that is safe to call from several threads.
+//  - void ResetArena(Arena *arena)                             - reuse the arena, its contents are undefined afterwards.
+//  - Bool ReleaseArena(Arena *arena)                           - free the arena.
+//  - Bool AdviseMemory(Bytes bytes, Uint32 advice)             - tell the system how bytes will be accessed.
+//  - Uint64 AtomicLoad64(volatile Uint64 *address)            - read address with acquire ordering.
+//  - void AtomicStore64(volatile Uint64 *address, Uint64 value)
+//                                                              - write address with release ordering.
+//  - Uint64 AtomicAdd64(volatile Uint64 *address, Uint64 value)
+//                                                              - add to address, return the previous value.
+//  - Bool AtomicCompareExchange64(volatile Uint64 *address, Uint64 *expected, Uint64 desired)
+//                                                              - replace expected with desired, or load the current value.
+//  - Bool InitSlotMap(Uint64 elementSize, Uint64 capacity, SlotMap *slotMap)
+//                                                              - allocate room for capacity elements.
+//  - Bool SlotMapInsert(SlotMap *slotMap, Uint64 *handle, Bytes *element)
+//                                                              - add a zeroed element, return its handle and bytes.
+//  - Bool SlotMapGet(SlotMap *slotMap, Uint64 handle, Bytes *element)
+//                                                              - find the element of handle, false when stale.
+//  - Bool SlotMapRemove(SlotMap *slotMap, Uint64 handle)       - remove the element of handle, false when stale.
+//  - Bool ReleaseSlotMap(SlotMap *slotMap)                     - free the slot map.
+//  - Bool InitConcurrentMap(Uint64 capacity, ConcurrentMap *map)
+//                                                              - allocate a map for about capacity keys, it grows as needed.
+//  - Bool ConcurrentMapGet(ConcurrentMap *map, Uint64 key, Uint64 *value)
+//                                                              - find the value of key without writing to the map.
+//  - Bool ConcurrentMapPut(ConcurrentMap *map, Uint64 key, Uint64 value)
+//                                                              - set the value of a nonzero key, value below 2^63 - 1.
+//  - Bool ReleaseConcurrentMap(ConcurrentMap *map)             - free the map, no thread may be using it.
+//  - Bool InitSkipList(Arena *arena, SkipList *skipList)       - prepare an empty skip list whose nodes come from arena.
+//  - Bool SkipListInsert(SkipList *skipList, Uint64 key, Bytes value)
+//                                                              - add a copy of value under key, keys may repeat.
+//  - Bool SkipListFind(SkipList *skipList, Uint64 key, Bytes *value)
+//                                                              - find the value inserted last under key.
+//  - void SkipListSeek(SkipList *skipList, Uint64 key, Uint64 *cursor)
+//                                                              - set cursor so that SkipListNext starts at the first key >= key.
+//  - Bool SkipListNext(SkipList *skipList, Uint64 *cursor, Uint64 *key, Bytes *value)
+//                                                              - step cursor, 0 to start, through keys in order, false at the end.
+//  - Bool AllocColumns(Uint64 count, const Uint64 *fieldSizes, Uint64 fieldCount, Bytes *columns, Bytes *bytes)
+//                                                              - alloc one cache line aligned column per field.
+//  - void ScatterColumns(Bytes rows, Uint64 rowSize, const Uint64 *fieldOffsets, const Uint64 *fieldSizes, Uint64 fieldCount, Bytes *columns)
+//                                                              - copy the fields of an array of structs into columns.
+//  - void GatherColumns(const Bytes *columns, const Uint64 *fieldOffsets, const Uint64 *fieldSizes, Uint64 fieldCount, Uint64 rowSize, Bytes rows)
+//                                                              - copy columns back into an array of structs.
+//  - Bool MapFileArray(const char *filePath, Uint64 elementSize, Uint64 elementAlignment, Bytes *fileMap, Uint64 *count)
+//                                                              - map a file that must hold a whole number of aligned elements.
+//  - Uint32 CpuFeatures(void)                                 - instruction sets usable on this CPU, 0 on non-x86.
+//  - Bool AllocShared(Uint64 size, Bytes *bytes)               - alloc memory shared with child processes, free with UnmapFile.
+//  - Bool InitSharedMutex(SharedMutex *mutex)                  - prepare a mutex that may live in shared memory.
+//  - Bool LockSharedMutex(SharedMutex *mutex, Bool *ownerDied)
+//                                                              - lock mutex, reporting whether its last owner died holding it.
+//  - Bool UnlockSharedMutex(SharedMutex *mutex)                - unlock mutex.
+//  - Bool InitSharedCondition(SharedCondition *condition)      - prepare a condition variable that may live in shared memory.
+//  - Bool WaitSharedCondition(SharedCondition *condition, SharedMutex *mutex, Bool *ownerDied)
+//                                                              - unlock mutex, wait for a signal and lock mutex again.
+//  - Bool SignalSharedCondition(SharedCondition *condition)    - wake one waiter.
+//  - Bool BroadcastSharedCondition(SharedCondition *condition) - wake every waiter.
+//  - Bool InitSharedRwLock(SharedRwLock *lock)                 - prepare a reader-writer lock that may live in shared memory.
+//  - Bool ReadLockSharedRwLock(SharedRwLock *lock)             - lock for reading.
+//  - Bool WriteLockSharedRwLock(SharedRwLock *lock)            - lock for writing.
+//  - Bool UnlockSharedRwLock(SharedRwLock *lock)               - release a read or write lock.
+//  - Bool InitChannel(Bytes bytes, Channel *channel)           - format shared bytes as an empty channel.
+//  - Bool OpenChannel(Bytes bytes, Channel *channel)           - attach to a channel formatted by InitChannel.
+//  - Bool ChannelReserve(Channel *channel, Uint64 size, Bytes *frame)
+//                                                              - wait for room and reserve a frame of size bytes to write, which with its
+//                                                                8-byte length and padding must fit in half the capacity.
+//  - void ChannelCommit(Channel *channel, Bytes frame)         - publish a reserved frame to the reader.
+//  - Bool ChannelPeek(Channel *channel, Bytes *frame)          - wait for the next frame and return it in place.
+//  - Bool ChannelPoll(Channel *channel, Bytes *frame)          - return the next frame in place, or a NULL frame if none is ready.
+//  - void ChannelRelease(Channel *channel, Bytes frame)        - give the space of a peeked frame back to the writer.
+//  - Bool AllocSealable(Uint64 size, Bytes *bytes, Int64 *handle)
+//                                                              - alloc read-write memory backed by a sealable memory file.
+//  - Bool SealBytes(Bytes *bytes, Int64 handle)                - make sealable bytes permanently readonly and fixed in size, left writable on failure.
+//  - Bool MapSealedHandle(Int64 handle, Bytes *bytes)          - map a sealed memory file readonly, free with UnmapFile.
+//  - Bool SendHandle(Int64 socket, Int64 handle)               - pass handle to the process on the other end of a Unix socket.
+//  - Bool ReceiveHandle(Int64 socket, Int64 *handle)           - receive a handle passed with SendHandle.
+//  - Bool CloseFileHandle(Int64 handle)                        - close a handle.
+//  - Bool MarkMergeable(Bytes bytes)                           - let the kernel share pages of bytes that are identical.
+//  - Bool GetMergedMemory(Uint64 *processBytes, Uint64 *systemBytes)
+//                                                              - memory merged in this process, 0 before Linux 6.1, and saved system wide.
+//  - Bool StartSnapshot(const char *filePath, const Bytes *regions, Uint64 regionCount, Snapshot *snapshot)
+//                                                              - write regions to a file from a forked child process.
+//  - Bool WaitSnapshot(Snapshot *snapshot, Uint64 *copiedPages)
+//                                                              - wait for a snapshot, count the pages copied meanwhile.
 
 #ifndef OS_H
 #define OS_H
@@ -43,6 +220,15 @@
 #define TRACE_ERROR(cstr)
 #endif
 
+#define CACHE_LINE_SIZE 64
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PREFETCH(address) _mm_prefetch((const char*) (address), _MM_HINT_T0)
+#else
+#define PREFETCH(address) __builtin_prefetch((address))
+#endif
+
 typedef char Bool;
 #define TRUE 1
 #define FALSE 0
@@ -67,20 +253,679 @@ STATIC_ASSERT(sizeof(Uint16) == 2);
 STATIC_ASSERT(sizeof(Uint32) == 4);
 STATIC_ASSERT(sizeof(Uint64) == 8);
 
+typedef float Float32;
+typedef double Float64;
+
+STATIC_ASSERT(sizeof(Float32) == 4);
+STATIC_ASSERT(sizeof(Float64) == 8);
+
 typedef struct {
     Uint8 *base;
     Uint64 size;
 } Bytes;
 
+#define ADVISE_NORMAL 0
+#define ADVISE_RANDOM 1
+#define ADVISE_SEQUENTIAL 2
+#define ADVISE_WILL_NEED 3
+
+#define CPU_SSE2 (1u << 0)
+#define CPU_SSSE3 (1u << 1)
+#define CPU_SSE41 (1u << 2)
+#define CPU_AVX2 (1u << 3)
+#define CPU_AVX512F (1u << 4)
+#define CPU_AVX512BW (1u << 5)
+
+typedef struct {
+    Bytes buffer;
+    Uint64 capacity;
+    Uint64 used;
+    Int64 handle;
+    Bool splice;
+} Writer;
+
+typedef struct {
+    Uint64 blockSize;
+    Uint64 chunkSize;
+    Uint8 *freeList;
+    Uint8 *next;
+    Uint8 *end;
+    Uint8 *chunks;
+} Pool;
+
+typedef struct {
+    Bytes bytes;
+    Uint64 used;
+} Arena;
+
+// Live elements are kept densely in the first count * elementSize bytes of
+// elements, in no particular order, so they can be iterated as an array.
+typedef struct {
+    Bytes bytes;
+    Uint8 *elements;
+    Uint32 *slots;
+    Uint32 *owners;
+    Uint64 elementSize;
+    Uint64 capacity;
+    Uint64 count;
+    Uint64 used;
+    Uint64 freeSlot;
+} SlotMap;
+
+// Every function except ReleaseConcurrentMap may be called from any number of
+// threads at once.
+typedef struct {
+    Uint64 table;
+    Uint64 retired;
+} ConcurrentMap;
+
+// Nodes are carved out of arena with ArenaAllocConcurrent and never freed on
+// their own; ResetArena followed by InitSkipList drops them all. Inserts, finds
+// and iteration may run on any number of threads at once.
+typedef struct {
+    Arena *arena;
+    Uint64 head;
+    Uint64 height;
+} SkipList;
+
+// Process shared locks are opaque, cache line sized storage for the system's
+// own lock types, so they can be placed directly in shared memory.
+typedef struct {
+    Uint64 storage[8];
+} SharedMutex;
+
+typedef struct {
+    Uint64 storage[8];
+} SharedCondition;
+
+typedef struct {
+    Uint64 storage[8];
+} SharedRwLock;
+
+typedef struct {
+    Uint8 *shared;
+    Uint8 *data;
+    Uint64 capacity;
+} Channel;
+
+// pipe becomes readable when the snapshot is done, so it can be polled.
+typedef struct {
+    Int64 process;
+    Int64 pipe;
+    Int64 faults;
+} Snapshot;
+
 Bool Alloc(Uint64 size, Bytes *bytes);
 Bool Free(Bytes bytes);
 Bool MapFile(const char *filePath, Bytes *fileMap);
 Bool UnmapFile(Bytes fileMap);
+Bool MapFileRange(const char *filePath, Uint64 offset, Uint64 size, Bytes *fileMap);
+
+Bool ParseUint64(Bytes bytes, Uint64 *value);
+Bool ParseInt64(Bytes bytes, Int64 *value);
+Bool ParseFloat64(Bytes bytes, Float64 *value);
+Bool ParseInt64s(Bytes bytes, Uint8 delimiter, Int64 *values, Uint64 capacity, Uint64 *count);
+Bool ParseFloat64s(Bytes bytes, Uint8 delimiter, Float64 *values, Uint64 capacity, Uint64 *count);
+
+Bool FormatUint64(Uint64 value, Bytes buffer, Uint64 *length);
+Bool FormatInt64(Int64 value, Bytes buffer, Uint64 *length);
+Bool FormatFloat64(Float64 value, Bytes buffer, Uint64 *length);
+Bool FormatTimestamp(Int64 unixSeconds, Bytes buffer, Uint64 *length);
+
+Bool OpenStdoutWriter(Uint64 size, Writer *writer);
+Bool WriteBytes(Writer *writer, Bytes bytes);
+Bool FlushWriter(Writer *writer);
+Bool CloseWriter(Writer *writer);
+
+void EncodeDelta(Uint32 *values, Uint64 count);
+void DecodeDelta(Uint32 *values, Uint64 count);
+Uint64 StreamVByteSize(Uint64 count);
+Bool EncodeStreamVByte(const Uint32 *values, Uint64 count, Bytes buffer, Uint64 *length);
+Bool DecodeStreamVByte(Bytes bytes, Uint64 count, Uint32 *values);
+Uint32 BitWidth(const Uint32 *values, Uint64 count, Uint32 reference);
+Bool PackBits(const Uint32 *values, Uint64 count, Uint32 reference, Uint32 bitWidth, Bytes buffer, Uint64 *length);
+Bool UnpackBits(Bytes bytes, Uint64 count, Uint32 reference, Uint32 bitWidth, Uint32 *values);
+
+Uint64 IntersectSorted(const Uint32 *a, Uint64 aCount, const Uint32 *b, Uint64 bCount, Uint32 *out);
+Uint64 UnionSorted(const Uint32 *a, Uint64 aCount, const Uint32 *b, Uint64 bCount, Uint32 *out);
+Uint64 DifferenceSorted(const Uint32 *a, Uint64 aCount, const Uint32 *b, Uint64 bCount, Uint32 *out);
+Uint64 IntersectSortedMany(const Uint32 *const *lists, const Uint64 *counts, Uint64 listCount, Uint32 *out);
+
+Bool MapFileWritable(const char *filePath, Uint64 size, Bytes *fileMap);
+Bool GrowFileMap(const char *filePath, Uint64 size, Bytes *fileMap);
+Bool FlushFileMap(Bytes bytes);
+
+Bool AppendFile(const char *filePath, Bytes bytes, Bool sync);
+
+Bool InitPool(Uint64 blockSize, Uint64 blocksPerChunk, Pool *pool);
+Bool PoolAlloc(Pool *pool, Bytes *bytes);
+void PoolFree(Pool *pool, Bytes bytes);
+Bool ReleasePool(Pool *pool);
+
+Bool InitArena(Uint64 size, Arena *arena);
+Bool ArenaAlloc(Arena *arena, Uint64 size, Uint64 alignment, Bytes *bytes);
+Bool ArenaAllocConcurrent(Arena *arena, Uint64 size, Uint64 alignment, Bytes *bytes);
+void ResetArena(Arena *arena);
+Bool ReleaseArena(Arena *arena);
+
+Bool AdviseMemory(Bytes bytes, Uint32 advice);
+
+Uint64 AtomicLoad64(volatile Uint64 *address);
+void AtomicStore64(volatile Uint64 *address, Uint64 value);
+Uint64 AtomicAdd64(volatile Uint64 *address, Uint64 value);
+Bool AtomicCompareExchange64(volatile Uint64 *address, Uint64 *expected, Uint64 desired);
+
+Bool InitSlotMap(Uint64 elementSize, Uint64 capacity, SlotMap *slotMap);
+Bool SlotMapInsert(SlotMap *slotMap, Uint64 *handle, Bytes *element);
+Bool SlotMapGet(SlotMap *slotMap, Uint64 handle, Bytes *element);
+Bool SlotMapRemove(SlotMap *slotMap, Uint64 handle);
+Bool ReleaseSlotMap(SlotMap *slotMap);
+
+Bool InitConcurrentMap(Uint64 capacity, ConcurrentMap *map);
+Bool ConcurrentMapGet(ConcurrentMap *map, Uint64 key, Uint64 *value);
+Bool ConcurrentMapPut(ConcurrentMap *map, Uint64 key, Uint64 value);
+Bool ReleaseConcurrentMap(ConcurrentMap *map);
+
+Bool InitSkipList(Arena *arena, SkipList *skipList);
+Bool SkipListInsert(SkipList *skipList, Uint64 key, Bytes value);
+Bool SkipListFind(SkipList *skipList, Uint64 key, Bytes *value);
+void SkipListSeek(SkipList *skipList, Uint64 key, Uint64 *cursor);
+Bool SkipListNext(SkipList *skipList, Uint64 *cursor, Uint64 *key, Bytes *value);
+
+Bool AllocColumns(Uint64 count, const Uint64 *fieldSizes, Uint64 fieldCount, Bytes *columns, Bytes *bytes);
+void ScatterColumns(Bytes rows, Uint64 rowSize, const Uint64 *fieldOffsets, const Uint64 *fieldSizes, Uint64 fieldCount, Bytes *columns);
+void GatherColumns(const Bytes *columns, const Uint64 *fieldOffsets, const Uint64 *fieldSizes, Uint64 fieldCount, Uint64 rowSize, Bytes rows);
+
+Bool MapFileArray(const char *filePath, Uint64 elementSize, Uint64 elementAlignment, Bytes *fileMap, Uint64 *count);
+
+Uint32 CpuFeatures(void);
+
+Bool AllocShared(Uint64 size, Bytes *bytes);
+Bool InitSharedMutex(SharedMutex *mutex);
+Bool LockSharedMutex(SharedMutex *mutex, Bool *ownerDied);
+Bool UnlockSharedMutex(SharedMutex *mutex);
+Bool InitSharedCondition(SharedCondition *condition);
+Bool WaitSharedCondition(SharedCondition *condition, SharedMutex *mutex, Bool *ownerDied);
+Bool SignalSharedCondition(SharedCondition *condition);
+Bool BroadcastSharedCondition(SharedCondition *condition);
+Bool InitSharedRwLock(SharedRwLock *lock);
+Bool ReadLockSharedRwLock(SharedRwLock *lock);
+Bool WriteLockSharedRwLock(SharedRwLock *lock);
+Bool UnlockSharedRwLock(SharedRwLock *lock);
+
+Bool InitChannel(Bytes bytes, Channel *channel);
+Bool OpenChannel(Bytes bytes, Channel *channel);
+Bool ChannelReserve(Channel *channel, Uint64 size, Bytes *frame);
+void ChannelCommit(Channel *channel, Bytes frame);
+Bool ChannelPeek(Channel *channel, Bytes *frame);
+Bool ChannelPoll(Channel *channel, Bytes *frame);
+void ChannelRelease(Channel *channel, Bytes frame);
+
+Bool AllocSealable(Uint64 size, Bytes *bytes, Int64 *handle);
+Bool SealBytes(Bytes *bytes, Int64 handle);
+Bool MapSealedHandle(Int64 handle, Bytes *bytes);
+Bool SendHandle(Int64 socket, Int64 handle);
+Bool ReceiveHandle(Int64 socket, Int64 *handle);
+Bool CloseFileHandle(Int64 handle);
+
+Bool MarkMergeable(Bytes bytes);
+Bool GetMergedMemory(Uint64 *processBytes, Uint64 *systemBytes);
+
+Bool StartSnapshot(const char *filePath, const Bytes *regions, Uint64 regionCount, Snapshot *snapshot);
+Bool WaitSnapshot(Snapshot *snapshot, Uint64 *copiedPages);
+
+#if defined(__cplusplus) && __cplusplus >= 201703L
+
+#include <cassert>
+#include <memory_resource>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Allocations take whole pages from Alloc, so they are only worth it for large
+// buffers or as the upstream of another resource. LARGE_PAGES applies here too.
+// Alloc only aligns to a page, and with STATIC_ARENA_SIZE small sizes only to a
+// cache line, so over-aligned small requests take a page and larger
+// alignments are refused.
+class AllocResource : public std::pmr::memory_resource {
+    // Zero-byte requests must still return a unique pointer, and Alloc refuses
+    // zero bytes, so they take one byte.
+    static size_t allocSize(size_t size, size_t alignment) {
+        if (size == 0) {
+            size = 1;
+        }
+        return alignment > CACHE_LINE_SIZE && size < 4096 ? 4096 : size;
+    }
+
+    void *do_allocate(size_t size, size_t alignment) override {
+        Bytes bytes;
+        if (alignment > 4096 || !Alloc(allocSize(size, alignment), &bytes)) {
+            throw std::bad_alloc();
+        }
+        return bytes.base;
+    }
+
+    void do_deallocate(void *base, size_t size, size_t alignment) override {
+        Bytes bytes = {(Uint8*) base, allocSize(size, alignment)};
+        Free(bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return dynamic_cast<const AllocResource*>(&other) != nullptr;
+    }
+};
+
+// Deallocation does nothing; memory comes back with ResetArena or ReleaseArena.
+class ArenaResource : public std::pmr::memory_resource {
+public:
+    explicit ArenaResource(Arena *arena) : arena(arena) {}
+
+private:
+    Arena *arena;
+
+    void *do_allocate(size_t size, size_t alignment) override {
+        Bytes bytes;
+        if (!ArenaAlloc(arena, size, alignment, &bytes)) {
+            throw std::bad_alloc();
+        }
+        return bytes.base;
+    }
+
+    void do_deallocate(void *, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        const ArenaResource *resource = dynamic_cast<const ArenaResource*>(&other);
+        return resource != nullptr && resource->arena == arena;
+    }
+};
+
+// Requests that fit a pool block, such as container nodes, come from the pool;
+// anything larger, such as bucket arrays, goes to the upstream resource.
+class PoolResource : public std::pmr::memory_resource {
+public:
+    PoolResource(Pool *pool, std::pmr::memory_resource *upstream) : pool(pool), upstream(upstream) {}
+
+private:
+    Pool *pool;
+    std::pmr::memory_resource *upstream;
+
+    bool fits(size_t size, size_t alignment) const {
+        return size <= pool->blockSize && alignment <= 8;
+    }
+
+    void *do_allocate(size_t size, size_t alignment) override {
+        if (!fits(size, alignment)) {
+            return upstream->allocate(size, alignment);
+        }
+
+        Bytes bytes;
+        if (!PoolAlloc(pool, &bytes)) {
+            throw std::bad_alloc();
+        }
+        return bytes.base;
+    }
+
+    void do_deallocate(void *base, size_t size, size_t alignment) override {
+        if (!fits(size, alignment)) {
+            upstream->deallocate(base, size, alignment);
+            return;
+        }
+
+        Bytes bytes = {(Uint8*) base, pool->blockSize};
+        PoolFree(pool, bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        const PoolResource *resource = dynamic_cast<const PoolResource*>(&other);
+        return resource != nullptr && resource->pool == pool;
+    }
+};
+
+class ScopedBytes {
+public:
+    ScopedBytes() : bytes{nullptr, 0} {}
+    explicit ScopedBytes(Bytes bytes) : bytes(bytes) {}
+    ScopedBytes(ScopedBytes &&other) noexcept : bytes(other.release()) {}
+    ScopedBytes(const ScopedBytes&) = delete;
+    ScopedBytes &operator=(const ScopedBytes&) = delete;
+
+    ScopedBytes &operator=(ScopedBytes &&other) noexcept {
+        if (this != &other) {
+            reset();
+            bytes = other.release();
+        }
+        return *this;
+    }
+
+    ~ScopedBytes() {
+        reset();
+    }
+
+    Bytes get() const {
+        return bytes;
+    }
+
+    Bytes release() {
+        Bytes released = bytes;
+        bytes = Bytes{nullptr, 0};
+        return released;
+    }
+
+    void reset() {
+        if (bytes.base != nullptr) {
+            Free(bytes);
+            bytes = Bytes{nullptr, 0};
+        }
+    }
+
+private:
+    Bytes bytes;
+};
+
+class ScopedFileMap {
+public:
+    ScopedFileMap() : fileMap{nullptr, 0} {}
+    explicit ScopedFileMap(Bytes fileMap) : fileMap(fileMap) {}
+    ScopedFileMap(ScopedFileMap &&other) noexcept : fileMap(other.release()) {}
+    ScopedFileMap(const ScopedFileMap&) = delete;
+    ScopedFileMap &operator=(const ScopedFileMap&) = delete;
+
+    ScopedFileMap &operator=(ScopedFileMap &&other) noexcept {
+        if (this != &other) {
+            reset();
+            fileMap = other.release();
+        }
+        return *this;
+    }
+
+    ~ScopedFileMap() {
+        reset();
+    }
+
+    Bytes get() const {
+        return fileMap;
+    }
+
+    Bytes release() {
+        Bytes released = fileMap;
+        fileMap = Bytes{nullptr, 0};
+        return released;
+    }
+
+    void reset() {
+        if (fileMap.base != nullptr) {
+            UnmapFile(fileMap);
+            fileMap = Bytes{nullptr, 0};
+        }
+    }
+
+private:
+    Bytes fileMap;
+};
+
+template <typename T>
+class ArrayView {
+public:
+    ArrayView() : elements(nullptr), count(0) {}
+    ArrayView(const T *elements, Uint64 count) : elements(elements), count(count) {}
+
+    const T &operator[](Uint64 index) const {
+        assert(index < count);
+        return elements[index];
+    }
+
+    ArrayView subview(Uint64 offset, Uint64 length) const {
+        assert(offset <= count && length <= count - offset);
+        return ArrayView(elements + offset, length);
+    }
+
+    const T *data() const {
+        return elements;
+    }
+
+    Uint64 size() const {
+        return count;
+    }
+
+    const T *begin() const {
+        return elements;
+    }
+
+    const T *end() const {
+        return elements + count;
+    }
+
+private:
+    const T *elements;
+    Uint64 count;
+};
+
+// T must be safe to read straight out of file bytes: trivially copyable and
+// standard layout, so its layout is fixed by its declaration alone.
+template <typename T>
+class MappedArray {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedArray requires a trivially copyable type");
+    static_assert(std::is_standard_layout<T>::value, "MappedArray requires a standard layout type");
+
+public:
+    MappedArray() = default;
+
+    MappedArray(MappedArray &&other) noexcept : fileMap(std::move(other.fileMap)), elements(other.elements) {
+        other.elements = ArrayView<T>();
+    }
+
+    MappedArray &operator=(MappedArray &&other) noexcept {
+        if (this != &other) {
+            fileMap = std::move(other.fileMap);
+            elements = other.elements;
+            other.elements = ArrayView<T>();
+        }
+        return *this;
+    }
+
+    static Bool Map(const char *filePath, MappedArray *array) {
+        Bytes fileMap;
+        Uint64 count;
+        if (!MapFileArray(filePath, sizeof(T), alignof(T), &fileMap, &count)) {
+            return FALSE;
+        }
+
+        array->fileMap = ScopedFileMap(fileMap);
+        array->elements = ArrayView<T>((const T*) fileMap.base, count);
+
+        return TRUE;
+    }
+
+    const T &operator[](Uint64 index) const {
+        return elements[index];
+    }
+
+    ArrayView<T> view() const {
+        return elements;
+    }
+
+    Uint64 size() const {
+        return elements.size();
+    }
+
+    const T *begin() const {
+        return elements.begin();
+    }
+
+    const T *end() const {
+        return elements.end();
+    }
+
+private:
+    ScopedFileMap fileMap;
+    ArrayView<T> elements;
+};
+
+// Rows are tuples of references into every column, so structured bindings and
+// tuple assignment read and write one row; loops over one field should go over
+// column<I>() instead, which is contiguous and cache line aligned.
+template <typename... Fields>
+class Columns {
+    static_assert(sizeof...(Fields) > 0, "Columns requires at least one field");
+    static_assert((std::is_trivially_copyable<Fields>::value && ...), "Columns requires trivially copyable fields");
+    static_assert(((alignof(Fields) <= CACHE_LINE_SIZE) && ...), "Columns requires fields aligned to at most a cache line");
+
+public:
+    template <size_t I>
+    using Field = typename std::tuple_element<I, std::tuple<Fields...>>::type;
+
+    Columns() : bases(), count(0) {}
+
+    Columns(Columns &&other) noexcept : bytes(std::move(other.bytes)), bases(other.bases), count(other.count) {
+        other.bases = std::tuple<Fields*...>();
+        other.count = 0;
+    }
+
+    Columns &operator=(Columns &&other) noexcept {
+        if (this != &other) {
+            bytes = std::move(other.bytes);
+            bases = other.bases;
+            count = other.count;
+            other.bases = std::tuple<Fields*...>();
+            other.count = 0;
+        }
+        return *this;
+    }
+
+    // An empty table owns no memory, since Alloc refuses zero bytes.
+    static Bool Alloc(Uint64 count, Columns *columns) {
+        if (count == 0) {
+            *columns = Columns();
+            return TRUE;
+        }
+
+        const Uint64 fieldSizes[] = {sizeof(Fields)...};
+        Bytes spans[sizeof...(Fields)];
+        Bytes allocation;
+        if (!AllocColumns(count, fieldSizes, sizeof...(Fields), spans, &allocation)) {
+            return FALSE;
+        }
+
+        columns->bytes = ScopedBytes(allocation);
+        columns->bases = Bind(spans, std::index_sequence_for<Fields...>());
+        columns->count = count;
+
+        return TRUE;
+    }
+
+    template <size_t I>
+    Field<I> *column() const {
+        return std::get<I>(bases);
+    }
+
+    std::tuple<Fields&...> operator[](Uint64 index) const {
+        assert(index < count);
+        return Row(index, std::index_sequence_for<Fields...>());
+    }
+
+    Uint64 size() const {
+        return count;
+    }
+
+    // Copies size() rows into the columns, field I from the member members[I]:
+    // columns.Scatter(rows, &Row::id, &Row::price).
+    template <typename Row>
+    void Scatter(const Row *rows, Fields Row::*... members) {
+        ScatterFields(rows, std::make_tuple(members...), std::index_sequence_for<Fields...>());
+    }
+
+    // Copies the columns back into size() rows, the inverse of Scatter.
+    template <typename Row>
+    void Gather(Row *rows, Fields Row::*... members) const {
+        GatherFields(rows, std::make_tuple(members...), std::index_sequence_for<Fields...>());
+    }
+
+private:
+    ScopedBytes bytes;
+    std::tuple<Fields*...> bases;
+    Uint64 count;
+
+    // One field at a time, like ScatterColumns, so each pass writes a single
+    // column sequentially.
+    template <typename Row, typename Members, size_t... I>
+    void ScatterFields(const Row *rows, const Members &members, std::index_sequence<I...>) {
+        ([&] {
+            Field<I> *column = std::get<I>(bases);
+            Field<I> Row::*member = std::get<I>(members);
+            for (Uint64 row = 0; row < count; ++row) {
+                column[row] = rows[row].*member;
+            }
+        }(), ...);
+    }
+
+    template <typename Row, typename Members, size_t... I>
+    void GatherFields(Row *rows, const Members &members, std::index_sequence<I...>) const {
+        ([&] {
+            const Field<I> *column = std::get<I>(bases);
+            Field<I> Row::*member = std::get<I>(members);
+            for (Uint64 row = 0; row < count; ++row) {
+                rows[row].*member = column[row];
+            }
+        }(), ...);
+    }
+
+    template <size_t... I>
+    static std::tuple<Fields*...> Bind(const Bytes *spans, std::index_sequence<I...>) {
+        return std::tuple<Fields*...>((Fields*) spans[I].base...);
+    }
+
+    template <size_t... I>
+    std::tuple<Fields&...> Row(Uint64 index, std::index_sequence<I...>) const {
+        return std::tuple<Fields&...>(std::get<I>(bases)[index]...);
+    }
+};
+
+#endif
 
 #endif
 
 #if defined(OS_IMPLEMENTATION)
 
+#if defined(STATIC_ARENA_SIZE)
+
+// The static arena lives in zero-initialized memory that the loader maps for
+// free, so early allocations need no syscall. Its memory is never reused, which
+// keeps the zeroed contents Alloc promises, and Free on it does nothing.
+// Allocations of a page or more start on a 4096 byte boundary like system
+// allocations, so they can be passed to page based calls; smaller ones only
+// start on a cache line.
+#if defined(_MSC_VER)
+__declspec(align(4096)) static Uint8 staticArena[STATIC_ARENA_SIZE];
+#else
+static Uint8 staticArena[STATIC_ARENA_SIZE] __attribute__((aligned(4096)));
+#endif
+
+static volatile Uint64 staticArenaUsed = 0;
+
+Bool StaticArenaAlloc(Uint64 size, Bytes *bytes) {
+    Uint64 used = AtomicLoad64(&staticArenaUsed);
+    Uint64 offset;
+    do {
+        Uint64 alignment = size >= 4096 ? 4096 : CACHE_LINE_SIZE;
+        offset = (used + alignment - 1) & ~(alignment - 1);
+        if (offset > STATIC_ARENA_SIZE || size > STATIC_ARENA_SIZE - offset) {
+            return FALSE;
+        }
+    } while (!AtomicCompareExchange64(&staticArenaUsed, &used, offset + size));
+
+    bytes->size = size;
+    bytes->base = staticArena + offset;
+
+    return TRUE;
+}
+
+Bool InStaticArena(Bytes bytes) {
+    return bytes.base >= staticArena && bytes.base < staticArena + STATIC_ARENA_SIZE;
+}
+
+#endif
+
 #ifdef _WIN32
 
 #define WIN32_LEAN_AND_MEAN
@@ -114,6 +959,12 @@ void TraceError() {
 }
 
 Bool Alloc(Uint64 size, Bytes *bytes) {
+#if defined(STATIC_ARENA_SIZE)
+    if (StaticArenaAlloc(size, bytes)) {
+        return TRUE;
+    }
+#endif
+
 #if defined(LARGE_PAGES)
     Int64 largePages = MEM_LARGE_PAGES;
 #else
@@ -138,6 +989,12 @@ Bool Alloc(Uint64 size, Bytes *bytes) {
 }
 
 Bool Free(Bytes bytes) {
+#if defined(STATIC_ARENA_SIZE)
+    if (InStaticArena(bytes)) {
+        return TRUE;
+    }
+#endif
+
     if (VirtualFree((LPVOID) bytes.base, 0, MEM_RELEASE) == 0) {
         TraceError();
         return FALSE;
@@ -226,7 +1083,13 @@ Bool UnmapFile(Bytes fileMap) {
         return TRUE;
     }
 
-    LPVOID pMapView = (LPVOID) fileMap.base;
+    // Views start on the allocation granularity, while MapFileRange may return a
+    // base further into the view.
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    SIZE_T granularity = (SIZE_T) systemInfo.dwAllocationGranularity;
+
+    LPVOID pMapView = (LPVOID) ((SIZE_T) fileMap.base / granularity * granularity);
     if (!UnmapViewOfFile(pMapView)) {
         TraceError();
         return FALSE;
@@ -235,115 +1098,4719 @@ Bool UnmapFile(Bytes fileMap) {
     return TRUE;
 }
 
-#elif defined(__unix__)
-
-#include <fcntl.h>
-#include <sys/stat.h>
-#include <unistd.h>
-#include <sys/mman.h>
-#include <errno.h>
-#include <string.h>
-
-Bool Alloc(Uint64 size, Bytes *bytes) {
-#if defined(LARGE_PAGES)
-    Int64 largePages = MAP_HUGETLB;
-#else
-    Int64 largePages = 0;
-#endif
+Bool OpenStdoutWriter(Uint64 size, Writer *writer) {
+    HANDLE hStdout = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (hStdout == INVALID_HANDLE_VALUE || hStdout == NULL) {
+        TraceError();
+        return FALSE;
+    }
 
-    void *base = mmap(
-        NULL,
-        (size_t) size,
-        PROT_READ | PROT_WRITE,
-        MAP_PRIVATE | MAP_ANONYMOUS | largePages,
-        -1,
-        0
-    );
-    if (base == MAP_FAILED) {
-        TRACE_ERROR(strerror(errno));
+    if (!Alloc(size, &writer->buffer)) {
         return FALSE;
     }
 
-    bytes->size = size;
-    bytes->base = (Uint8*) base;
+    writer->capacity = size;
+    writer->used = 0;
+    writer->handle = (Int64) (INT_PTR) hStdout;
+    writer->splice = FALSE;
 
     return TRUE;
 }
 
-Bool Free(Bytes bytes) {
-    if (munmap((void *) bytes.base, (size_t) bytes.size) != 0) {
-        TRACE_ERROR(strerror(errno));
-        return FALSE;
+Bool WriteAll(Writer *writer, Uint8 *base, Uint64 size) {
+    HANDLE hOutput = (HANDLE) (INT_PTR) writer->handle;
+    while (size > 0) {
+        DWORD chunk = size > 0x40000000 ? 0x40000000 : (DWORD) size;
+        DWORD written;
+        if (!WriteFile(hOutput, base, chunk, &written, NULL)) {
+            TraceError();
+            return FALSE;
+        }
+
+        base += written;
+        size -= written;
     }
 
     return TRUE;
 }
 
-Bool MapFile(const char *filePath, Bytes *fileMap) {
-    int fd = open(
-        filePath,
-        O_RDONLY
-    );
-    if (fd == -1) {
-        TRACE_ERROR(strerror(errno));
-        return FALSE;
-    }
+Bool FlushWriter(Writer *writer) {
+    Uint64 used = writer->used;
+    writer->used = 0;
 
-    struct stat st;
-    if (fstat(fd, &st) == -1) {
-        TRACE_ERROR(strerror(errno));
-        close(fd);
+    return WriteAll(writer, writer->buffer.base, used);
+}
+
+Bool MapFileRange(const char *filePath, Uint64 offset, Uint64 size, Bytes *fileMap) {
+#if defined(UNICODE)
+    TCHAR tFilePath[MAX_PATH];
+    if (MultiByteToWideChar(CP_ACP, 0, filePath, -1, tFilePath, MAX_PATH) == 0) {
+        TraceError();
         return FALSE;
     }
-    size_t size = st.st_size;
-    if (size == 0) {
-        close(fd);
+#else
+    TCHAR *tFilePath = (TCHAR*) filePath;
+#endif
+
+    HANDLE hFile = CreateFile(
+        tFilePath,
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        NULL,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+    if (hFile == INVALID_HANDLE_VALUE) {
+        TraceError();
+        return FALSE;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize)) {
+        TraceError();
+        CloseHandle(hFile);
+        return FALSE;
+    }
+    if (offset > (Uint64) fileSize.QuadPart || size > (Uint64) fileSize.QuadPart - offset) {
+        TRACE_ERROR("File range is out of bounds");
+        CloseHandle(hFile);
+        return FALSE;
+    }
+
+    if (size == 0) {
+        CloseHandle(hFile);
         fileMap->size = 0;
         fileMap->base = NULL;
         return TRUE;
     }
 
-#if defined(LARGE_PAGES)
-    Int64 largePages = MAP_HUGETLB;
+    HANDLE hMapping = CreateFileMapping(
+        hFile,
+        NULL,
+        PAGE_READONLY,
+        0,
+        0,
+        NULL
+    );
+    if (hMapping == NULL) {
+        TraceError();
+        CloseHandle(hFile);
+        return FALSE;
+    }
+
+    // View offsets must be a multiple of the allocation granularity.
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    Uint64 delta = offset % systemInfo.dwAllocationGranularity;
+    Uint64 viewOffset = offset - delta;
+
+    LPVOID pMapView = MapViewOfFile(
+        hMapping,
+        FILE_MAP_READ,
+        (DWORD) (viewOffset >> 32),
+        (DWORD) viewOffset,
+        (SIZE_T) (size + delta)
+    );
+    if (pMapView == NULL) {
+        TraceError();
+        CloseHandle(hMapping);
+        CloseHandle(hFile);
+        return FALSE;
+    }
+
+    fileMap->size = size;
+    fileMap->base = (Uint8*) pMapView + delta;
+
+    CloseHandle(hMapping);
+    CloseHandle(hFile);
+
+    return TRUE;
+}
+
+Bool MapFileWritable(const char *filePath, Uint64 size, Bytes *fileMap) {
+#if defined(UNICODE)
+    TCHAR tFilePath[MAX_PATH];
+    if (MultiByteToWideChar(CP_ACP, 0, filePath, -1, tFilePath, MAX_PATH) == 0) {
+        TraceError();
+        return FALSE;
+    }
 #else
-    Int64 largePages = 0;
+    TCHAR *tFilePath = (TCHAR*) filePath;
 #endif
 
-    void *data = mmap(
+    HANDLE hFile = CreateFile(
+        tFilePath,
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ,
         NULL,
-        size,
-        PROT_READ,
-        MAP_PRIVATE | largePages,
-        fd,
+        OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+    if (hFile == INVALID_HANDLE_VALUE) {
+        TraceError();
+        return FALSE;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize)) {
+        TraceError();
+        CloseHandle(hFile);
+        return FALSE;
+    }
+    if ((Uint64) fileSize.QuadPart > size) {
+        size = (Uint64) fileSize.QuadPart;
+    }
+
+    if (size == 0) {
+        CloseHandle(hFile);
+        fileMap->size = 0;
+        fileMap->base = NULL;
+        return TRUE;
+    }
+
+    // A mapping larger than the file extends the file to the mapping size.
+    HANDLE hMapping = CreateFileMapping(
+        hFile,
+        NULL,
+        PAGE_READWRITE,
+        (DWORD) (size >> 32),
+        (DWORD) size,
+        NULL
+    );
+    if (hMapping == NULL) {
+        TraceError();
+        CloseHandle(hFile);
+        return FALSE;
+    }
+
+    LPVOID pMapView = MapViewOfFile(
+        hMapping,
+        FILE_MAP_WRITE,
+        0,
+        0,
         0
     );
-    if (data == MAP_FAILED) {
-        TRACE_ERROR(strerror(errno));
-        close(fd);
+    if (pMapView == NULL) {
+        TraceError();
+        CloseHandle(hMapping);
+        CloseHandle(hFile);
         return FALSE;
     }
 
-    fileMap->size = (Uint64) size;
-    fileMap->base = (Uint8*) data;
+    fileMap->size = size;
+    fileMap->base = (Uint8*) pMapView;
 
-    close(fd);
+    CloseHandle(hMapping);
+    CloseHandle(hFile);
 
     return TRUE;
 }
 
-Bool UnmapFile(Bytes fileMap) {
-    if (fileMap.base == NULL) {
+// FlushViewOfFile hands the pages to the file system; without the file handle,
+// which MapFileWritable does not keep, the disk cache itself is not flushed.
+Bool FlushFileMap(Bytes bytes) {
+    if (bytes.size == 0) {
         return TRUE;
     }
 
-    if (munmap((void *) fileMap.base, (size_t) fileMap.size) == -1) {
-        TRACE_ERROR(strerror(errno));
+    if (!FlushViewOfFile((LPCVOID) bytes.base, (SIZE_T) bytes.size)) {
+        TraceError();
         return FALSE;
     }
 
     return TRUE;
 }
 
+Bool AppendFile(const char *filePath, Bytes bytes, Bool sync) {
+#if defined(UNICODE)
+    TCHAR tFilePath[MAX_PATH];
+    if (MultiByteToWideChar(CP_ACP, 0, filePath, -1, tFilePath, MAX_PATH) == 0) {
+        TraceError();
+        return FALSE;
+    }
+#else
+    TCHAR *tFilePath = (TCHAR*) filePath;
 #endif
 
+    HANDLE hFile = CreateFile(
+        tFilePath,
+        FILE_APPEND_DATA,
+        FILE_SHARE_READ,
+        NULL,
+        OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+    if (hFile == INVALID_HANDLE_VALUE) {
+        TraceError();
+        return FALSE;
+    }
+
+    Uint8 *base = bytes.base;
+    Uint64 size = bytes.size;
+    while (size > 0) {
+        DWORD chunk = size > 0x40000000 ? 0x40000000 : (DWORD) size;
+        DWORD written;
+        if (!WriteFile(hFile, base, chunk, &written, NULL)) {
+            TraceError();
+            CloseHandle(hFile);
+            return FALSE;
+        }
+
+        base += written;
+        size -= written;
+    }
+
+    if (sync && !FlushFileBuffers(hFile)) {
+        TraceError();
+        CloseHandle(hFile);
+        return FALSE;
+    }
+
+    CloseHandle(hFile);
+
+    return TRUE;
+}
+
+// Windows only acts on ADVISE_WILL_NEED; the other hints have no equivalent
+// for an existing view and succeed without doing anything.
+Bool AdviseMemory(Bytes bytes, Uint32 advice) {
+    if (advice != ADVISE_WILL_NEED || bytes.size == 0) {
+        return TRUE;
+    }
+
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = (PVOID) bytes.base;
+    range.NumberOfBytes = (SIZE_T) bytes.size;
+
+    if (!PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0)) {
+        TraceError();
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Uint64 AtomicLoad64(volatile Uint64 *address) {
+    return (Uint64) ReadAcquire64((volatile LONG64 *) address);
+}
+
+void AtomicStore64(volatile Uint64 *address, Uint64 value) {
+    WriteRelease64((volatile LONG64 *) address, (LONG64) value);
+}
+
+Uint64 AtomicAdd64(volatile Uint64 *address, Uint64 value) {
+    return (Uint64) InterlockedExchangeAdd64((volatile LONG64 *) address, (LONG64) value);
+}
+
+Bool AtomicCompareExchange64(volatile Uint64 *address, Uint64 *expected, Uint64 desired) {
+    Uint64 previous = (Uint64) InterlockedCompareExchange64(
+        (volatile LONG64 *) address,
+        (LONG64) desired,
+        (LONG64) *expected
+    );
+    if (previous != *expected) {
+        *expected = previous;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool AllocShared(Uint64 size, Bytes *bytes) {
+    HANDLE hMapping = CreateFileMapping(
+        INVALID_HANDLE_VALUE,
+        NULL,
+        PAGE_READWRITE,
+        (DWORD) (size >> 32),
+        (DWORD) size,
+        NULL
+    );
+    if (hMapping == NULL) {
+        TraceError();
+        return FALSE;
+    }
+
+    LPVOID pMapView = MapViewOfFile(
+        hMapping,
+        FILE_MAP_WRITE,
+        0,
+        0,
+        0
+    );
+    if (pMapView == NULL) {
+        TraceError();
+        CloseHandle(hMapping);
+        return FALSE;
+    }
+
+    bytes->size = size;
+    bytes->base = (Uint8*) pMapView;
+
+    CloseHandle(hMapping);
+
+    return TRUE;
+}
+
+// Windows has no lock that can be placed in memory shared between processes;
+// its equivalents are named kernel objects, which do not fit this API.
+Bool InitSharedMutex(SharedMutex *mutex) {
+    TRACE_ERROR("Process shared locks are not supported on Windows");
+    return FALSE;
+}
+
+Bool LockSharedMutex(SharedMutex *mutex, Bool *ownerDied) {
+    TRACE_ERROR("Process shared locks are not supported on Windows");
+    return FALSE;
+}
+
+Bool UnlockSharedMutex(SharedMutex *mutex) {
+    TRACE_ERROR("Process shared locks are not supported on Windows");
+    return FALSE;
+}
+
+Bool InitSharedCondition(SharedCondition *condition) {
+    TRACE_ERROR("Process shared locks are not supported on Windows");
+    return FALSE;
+}
+
+Bool WaitSharedCondition(SharedCondition *condition, SharedMutex *mutex, Bool *ownerDied) {
+    TRACE_ERROR("Process shared locks are not supported on Windows");
+    return FALSE;
+}
+
+Bool SignalSharedCondition(SharedCondition *condition) {
+    TRACE_ERROR("Process shared locks are not supported on Windows");
+    return FALSE;
+}
+
+Bool BroadcastSharedCondition(SharedCondition *condition) {
+    TRACE_ERROR("Process shared locks are not supported on Windows");
+    return FALSE;
+}
+
+Bool InitSharedRwLock(SharedRwLock *lock) {
+    TRACE_ERROR("Process shared locks are not supported on Windows");
+    return FALSE;
+}
+
+Bool ReadLockSharedRwLock(SharedRwLock *lock) {
+    TRACE_ERROR("Process shared locks are not supported on Windows");
+    return FALSE;
+}
+
+Bool WriteLockSharedRwLock(SharedRwLock *lock) {
+    TRACE_ERROR("Process shared locks are not supported on Windows");
+    return FALSE;
+}
+
+Bool UnlockSharedRwLock(SharedRwLock *lock) {
+    TRACE_ERROR("Process shared locks are not supported on Windows");
+    return FALSE;
+}
+
+void FullMemoryBarrier() {
+    MemoryBarrier();
+}
+
+// WaitOnAddress only works within a process, so waiting on shared memory polls.
+void WaitOnWord(volatile Uint32 *word, Uint32 value) {
+    while (*word == value) {
+        SwitchToThread();
+    }
+}
+
+void WakeWord(volatile Uint32 *word) {
+}
+
+// Sealed memory files are a Linux feature with no Windows equivalent.
+Bool AllocSealable(Uint64 size, Bytes *bytes, Int64 *handle) {
+    TRACE_ERROR("Sealed memory files are not supported on Windows");
+    return FALSE;
+}
+
+Bool SealBytes(Bytes *bytes, Int64 handle) {
+    TRACE_ERROR("Sealed memory files are not supported on Windows");
+    return FALSE;
+}
+
+Bool MapSealedHandle(Int64 handle, Bytes *bytes) {
+    TRACE_ERROR("Sealed memory files are not supported on Windows");
+    return FALSE;
+}
+
+Bool SendHandle(Int64 socket, Int64 handle) {
+    TRACE_ERROR("Sealed memory files are not supported on Windows");
+    return FALSE;
+}
+
+Bool ReceiveHandle(Int64 socket, Int64 *handle) {
+    TRACE_ERROR("Sealed memory files are not supported on Windows");
+    return FALSE;
+}
+
+Bool CloseFileHandle(Int64 handle) {
+    if (!CloseHandle((HANDLE) (INT_PTR) handle)) {
+        TraceError();
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+// Windows combines identical pages on its own; there is nothing to opt into
+// and no per-process statistics to read.
+Bool MarkMergeable(Bytes bytes) {
+    return TRUE;
+}
+
+Bool GetMergedMemory(Uint64 *processBytes, Uint64 *systemBytes) {
+    TRACE_ERROR("Merged memory statistics are not supported on Windows");
+    return FALSE;
+}
+
+// Snapshots rely on fork's copy-on-write, which Windows does not offer.
+Bool StartSnapshot(const char *filePath, const Bytes *regions, Uint64 regionCount, Snapshot *snapshot) {
+    TRACE_ERROR("Snapshots are not supported on Windows");
+    return FALSE;
+}
+
+Bool WaitSnapshot(Snapshot *snapshot, Uint64 *copiedPages) {
+    TRACE_ERROR("Snapshots are not supported on Windows");
+    return FALSE;
+}
+
+#elif defined(__unix__)
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <errno.h>
+#include <string.h>
+
+Bool Alloc(Uint64 size, Bytes *bytes) {
+#if defined(STATIC_ARENA_SIZE)
+    if (StaticArenaAlloc(size, bytes)) {
+        return TRUE;
+    }
+#endif
+
+#if defined(LARGE_PAGES)
+    Int64 largePages = MAP_HUGETLB;
+#else
+    Int64 largePages = 0;
+#endif
+
+    void *base = mmap(
+        NULL,
+        (size_t) size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | largePages,
+        -1,
+        0
+    );
+    if (base == MAP_FAILED) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    bytes->size = size;
+    bytes->base = (Uint8*) base;
+
+    return TRUE;
+}
+
+Bool Free(Bytes bytes) {
+#if defined(STATIC_ARENA_SIZE)
+    if (InStaticArena(bytes)) {
+        return TRUE;
+    }
+#endif
+
+    if (munmap((void *) bytes.base, (size_t) bytes.size) != 0) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool MapFile(const char *filePath, Bytes *fileMap) {
+    int fd = open(
+        filePath,
+        O_RDONLY
+    );
+    if (fd == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+    size_t size = st.st_size;
+    if (size == 0) {
+        close(fd);
+        fileMap->size = 0;
+        fileMap->base = NULL;
+        return TRUE;
+    }
+
+#if defined(LARGE_PAGES)
+    Int64 largePages = MAP_HUGETLB;
+#else
+    Int64 largePages = 0;
+#endif
+
+    void *data = mmap(
+        NULL,
+        size,
+        PROT_READ,
+        MAP_PRIVATE | largePages,
+        fd,
+        0
+    );
+    if (data == MAP_FAILED) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+
+    fileMap->size = (Uint64) size;
+    fileMap->base = (Uint8*) data;
+
+    close(fd);
+
+    return TRUE;
+}
+
+Bool UnmapFile(Bytes fileMap) {
+    if (fileMap.base == NULL) {
+        return TRUE;
+    }
+
+    // MapFileRange may return a base further into the first mapped page.
+    size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    size_t delta = (size_t) fileMap.base % pageSize;
+
+    if (munmap((void *) (fileMap.base - delta), (size_t) fileMap.size + delta) == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+#if defined(__linux__)
+
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#ifndef SPLICE_F_GIFT
+#define SPLICE_F_GIFT 8
+#endif
+
+// Spliced buffers are mapped directly rather than with Alloc, which may hand
+// out static arena memory that would be reused, and are populated up front so
+// that refilling one does not fault page by page.
+Bool AllocWriterPages(Uint64 size, Bytes *bytes) {
+    void *base = mmap(
+        NULL,
+        (size_t) size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE,
+        -1,
+        0
+    );
+    if (base == MAP_FAILED) {
+        return FALSE;
+    }
+
+    bytes->size = size;
+    bytes->base = (Uint8*) base;
+
+    return TRUE;
+}
+
+#endif
+
+Bool OpenStdoutWriter(Uint64 size, Writer *writer) {
+    writer->capacity = size;
+    writer->used = 0;
+    writer->handle = STDOUT_FILENO;
+    writer->splice = FALSE;
+
+#if defined(__linux__)
+    // Pages handed to a pipe with vmsplice are referenced, not copied, and a
+    // reader that splices them on to another pipe or socket keeps them long after
+    // they left this pipe. So every full buffer is gifted to the pipe and never
+    // touched again: the writer continues in a freshly mapped buffer.
+    struct stat st;
+    long pageSize = sysconf(_SC_PAGESIZE);
+    Uint64 pages = (size + (Uint64) pageSize - 1) / (Uint64) pageSize * (Uint64) pageSize;
+    if (fstat(STDOUT_FILENO, &st) == 0 && S_ISFIFO(st.st_mode) && AllocWriterPages(pages, &writer->buffer)) {
+        writer->capacity = pages;
+        writer->splice = TRUE;
+        return TRUE;
+    }
+#endif
+
+    return Alloc(size, &writer->buffer);
+}
+
+Bool WriteAll(Writer *writer, Uint8 *base, Uint64 size) {
+    while (size > 0) {
+        ssize_t written = write((int) writer->handle, base, (size_t) size);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            TRACE_ERROR(strerror(errno));
+            return FALSE;
+        }
+
+        base += written;
+        size -= (Uint64) written;
+    }
+
+    return TRUE;
+}
+
+Bool FlushWriter(Writer *writer) {
+    Uint64 used = writer->used;
+    Uint8 *base = writer->buffer.base;
+    writer->used = 0;
+
+#if defined(__linux__)
+    // Only full buffers are gifted, since a gifted buffer is given up. Partial
+    // flushes, and full ones when no fresh buffer can be mapped, are copied.
+    Bytes fresh;
+    if (writer->splice && used == writer->capacity && AllocWriterPages(writer->capacity, &fresh)) {
+        Bytes spliced = writer->buffer;
+        writer->buffer = fresh;
+
+        while (used > 0) {
+            struct iovec iov = {base, (size_t) used};
+            ssize_t count = syscall(SYS_vmsplice, (int) writer->handle, &iov, 1UL, SPLICE_F_GIFT);
+            if (count == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                TRACE_ERROR(strerror(errno));
+                munmap((void *) spliced.base, (size_t) spliced.size);
+                return FALSE;
+            }
+
+            base += count;
+            used -= (Uint64) count;
+        }
+
+        // The pipe holds its own references to the pages, so only the mapping
+        // goes away here.
+        return Free(spliced);
+    }
+#endif
+
+    return WriteAll(writer, base, used);
+}
+
+Bool MapFileRange(const char *filePath, Uint64 offset, Uint64 size, Bytes *fileMap) {
+    int fd = open(
+        filePath,
+        O_RDONLY
+    );
+    if (fd == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+    if (offset > (Uint64) st.st_size || size > (Uint64) st.st_size - offset) {
+        TRACE_ERROR("File range is out of bounds");
+        close(fd);
+        return FALSE;
+    }
+
+    if (size == 0) {
+        close(fd);
+        fileMap->size = 0;
+        fileMap->base = NULL;
+        return TRUE;
+    }
+
+    // Mapping offsets must be a multiple of the page size. Large pages are not
+    // used here since file ranges rarely line up with them.
+    Uint64 delta = offset % (Uint64) sysconf(_SC_PAGESIZE);
+
+    void *data = mmap(
+        NULL,
+        (size_t) (size + delta),
+        PROT_READ,
+        MAP_PRIVATE,
+        fd,
+        (off_t) (offset - delta)
+    );
+    if (data == MAP_FAILED) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+
+    fileMap->size = size;
+    fileMap->base = (Uint8*) data + delta;
+
+    close(fd);
+
+    return TRUE;
+}
+
+Bool MapFileWritable(const char *filePath, Uint64 size, Bytes *fileMap) {
+    int fd = open(
+        filePath,
+        O_RDWR | O_CREAT,
+        0644
+    );
+    if (fd == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+    if ((Uint64) st.st_size > size) {
+        size = (Uint64) st.st_size;
+    } else if (ftruncate(fd, (off_t) size) == -1) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+
+    if (size == 0) {
+        close(fd);
+        fileMap->size = 0;
+        fileMap->base = NULL;
+        return TRUE;
+    }
+
+    void *data = mmap(
+        NULL,
+        (size_t) size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        fd,
+        0
+    );
+    if (data == MAP_FAILED) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+
+    fileMap->size = size;
+    fileMap->base = (Uint8*) data;
+
+    close(fd);
+
+    return TRUE;
+}
+
+#if defined(__linux__)
+
+#ifndef MREMAP_MAYMOVE
+#define MREMAP_MAYMOVE 1
+#endif
+
+// Extends the file and its mapping without unmapping it first; mremap only moves
+// the mapping when the address range above it is taken, and never copies pages.
+// The mapping is grown before the file so that a failed mremap leaves the file
+// untouched; if the file then cannot be extended the mapping is shrunk back to
+// its old size (fileMap is updated, as it may have moved) and FALSE is returned.
+Bool RemapFileWritable(const char *filePath, Uint64 size, Bytes *fileMap) {
+    int fd = open(filePath, O_RDWR);
+    if (fd == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+    Bool grow = (Uint64) st.st_size < size;
+    if (!grow) {
+        size = (Uint64) st.st_size;
+    }
+
+    void *data = (void*) syscall(SYS_mremap, fileMap->base, (size_t) fileMap->size, (size_t) size, MREMAP_MAYMOVE);
+    if (data == MAP_FAILED) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+
+    if (grow && ftruncate(fd, (off_t) size) == -1) {
+        TRACE_ERROR(strerror(errno));
+        syscall(SYS_mremap, data, (size_t) size, (size_t) fileMap->size, 0);
+        fileMap->base = (Uint8*) data;
+        close(fd);
+        return FALSE;
+    }
+
+    close(fd);
+
+    fileMap->size = size;
+    fileMap->base = (Uint8*) data;
+
+    return TRUE;
+}
+
+#endif
+
+Bool FlushFileMap(Bytes bytes) {
+    if (bytes.size == 0) {
+        return TRUE;
+    }
+
+    size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    size_t delta = (size_t) bytes.base % pageSize;
+
+    if (msync((void *) (bytes.base - delta), (size_t) bytes.size + delta, MS_SYNC) == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool AppendFile(const char *filePath, Bytes bytes, Bool sync) {
+    int fd = open(
+        filePath,
+        O_WRONLY | O_CREAT | O_APPEND,
+        0644
+    );
+    if (fd == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    Uint8 *base = bytes.base;
+    Uint64 size = bytes.size;
+    while (size > 0) {
+        ssize_t written = write(fd, base, (size_t) size);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            TRACE_ERROR(strerror(errno));
+            close(fd);
+            return FALSE;
+        }
+
+        base += written;
+        size -= (Uint64) written;
+    }
+
+#if defined(__linux__)
+    int synced = sync ? fdatasync(fd) : 0;
+#else
+    int synced = sync ? fsync(fd) : 0;
+#endif
+    if (synced == -1) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+
+    close(fd);
+
+    return TRUE;
+}
+
+Bool AdviseMemory(Bytes bytes, Uint32 advice) {
+    if (bytes.size == 0) {
+        return TRUE;
+    }
+
+    int flags = POSIX_MADV_NORMAL;
+    switch (advice) {
+        case ADVISE_RANDOM: flags = POSIX_MADV_RANDOM; break;
+        case ADVISE_SEQUENTIAL: flags = POSIX_MADV_SEQUENTIAL; break;
+        case ADVISE_WILL_NEED: flags = POSIX_MADV_WILLNEED; break;
+    }
+
+    size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    size_t delta = (size_t) bytes.base % pageSize;
+
+    int error = posix_madvise((void *) (bytes.base - delta), (size_t) bytes.size + delta, flags);
+    if (error != 0) {
+        TRACE_ERROR(strerror(error));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Uint64 AtomicLoad64(volatile Uint64 *address) {
+    return __atomic_load_n(address, __ATOMIC_ACQUIRE);
+}
+
+void AtomicStore64(volatile Uint64 *address, Uint64 value) {
+    __atomic_store_n(address, value, __ATOMIC_RELEASE);
+}
+
+Uint64 AtomicAdd64(volatile Uint64 *address, Uint64 value) {
+    return __atomic_fetch_add(address, value, __ATOMIC_ACQ_REL);
+}
+
+Bool AtomicCompareExchange64(volatile Uint64 *address, Uint64 *expected, Uint64 desired) {
+    return (Bool) __atomic_compare_exchange_n(
+        address,
+        expected,
+        desired,
+        0,
+        __ATOMIC_ACQ_REL,
+        __ATOMIC_ACQUIRE
+    );
+}
+
+#include <pthread.h>
+
+STATIC_ASSERT(sizeof(pthread_mutex_t) <= sizeof(SharedMutex));
+STATIC_ASSERT(sizeof(pthread_cond_t) <= sizeof(SharedCondition));
+STATIC_ASSERT(sizeof(pthread_rwlock_t) <= sizeof(SharedRwLock));
+
+Bool AllocShared(Uint64 size, Bytes *bytes) {
+    void *base = mmap(
+        NULL,
+        (size_t) size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_ANONYMOUS,
+        -1,
+        0
+    );
+    if (base == MAP_FAILED) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    bytes->size = size;
+    bytes->base = (Uint8*) base;
+
+    return TRUE;
+}
+
+// Mutexes are robust: when a process dies holding one, the next locker is told
+// through ownerDied, gets the lock, and should repair the data it protects. The
+// uncontended lock and unlock paths stay in user space.
+Bool InitSharedMutex(SharedMutex *mutex) {
+    pthread_mutexattr_t attributes;
+    int error = pthread_mutexattr_init(&attributes);
+    if (error == 0) {
+        error = pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    }
+    if (error == 0) {
+        error = pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+    }
+    if (error == 0) {
+        error = pthread_mutex_init((pthread_mutex_t *) mutex->storage, &attributes);
+    }
+    pthread_mutexattr_destroy(&attributes);
+
+    if (error != 0) {
+        TRACE_ERROR(strerror(error));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool RecoverSharedMutex(SharedMutex *mutex, int error, Bool *ownerDied) {
+    *ownerDied = FALSE;
+    if (error == EOWNERDEAD) {
+        *ownerDied = TRUE;
+        error = pthread_mutex_consistent((pthread_mutex_t *) mutex->storage);
+    }
+
+    if (error != 0) {
+        TRACE_ERROR(strerror(error));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool LockSharedMutex(SharedMutex *mutex, Bool *ownerDied) {
+    int error = pthread_mutex_lock((pthread_mutex_t *) mutex->storage);
+
+    return RecoverSharedMutex(mutex, error, ownerDied);
+}
+
+Bool UnlockSharedMutex(SharedMutex *mutex) {
+    int error = pthread_mutex_unlock((pthread_mutex_t *) mutex->storage);
+    if (error != 0) {
+        TRACE_ERROR(strerror(error));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool InitSharedCondition(SharedCondition *condition) {
+    pthread_condattr_t attributes;
+    int error = pthread_condattr_init(&attributes);
+    if (error == 0) {
+        error = pthread_condattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    }
+    if (error == 0) {
+        error = pthread_cond_init((pthread_cond_t *) condition->storage, &attributes);
+    }
+    pthread_condattr_destroy(&attributes);
+
+    if (error != 0) {
+        TRACE_ERROR(strerror(error));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool WaitSharedCondition(SharedCondition *condition, SharedMutex *mutex, Bool *ownerDied) {
+    int error = pthread_cond_wait((pthread_cond_t *) condition->storage, (pthread_mutex_t *) mutex->storage);
+
+    return RecoverSharedMutex(mutex, error, ownerDied);
+}
+
+Bool SignalSharedCondition(SharedCondition *condition) {
+    int error = pthread_cond_signal((pthread_cond_t *) condition->storage);
+    if (error != 0) {
+        TRACE_ERROR(strerror(error));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool BroadcastSharedCondition(SharedCondition *condition) {
+    int error = pthread_cond_broadcast((pthread_cond_t *) condition->storage);
+    if (error != 0) {
+        TRACE_ERROR(strerror(error));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+// Reader-writer locks are process shared but not robust; POSIX has no owner
+// death recovery for them.
+Bool InitSharedRwLock(SharedRwLock *lock) {
+    pthread_rwlockattr_t attributes;
+    int error = pthread_rwlockattr_init(&attributes);
+    if (error == 0) {
+        error = pthread_rwlockattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    }
+    if (error == 0) {
+        error = pthread_rwlock_init((pthread_rwlock_t *) lock->storage, &attributes);
+    }
+    pthread_rwlockattr_destroy(&attributes);
+
+    if (error != 0) {
+        TRACE_ERROR(strerror(error));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool ReadLockSharedRwLock(SharedRwLock *lock) {
+    int error = pthread_rwlock_rdlock((pthread_rwlock_t *) lock->storage);
+    if (error != 0) {
+        TRACE_ERROR(strerror(error));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool WriteLockSharedRwLock(SharedRwLock *lock) {
+    int error = pthread_rwlock_wrlock((pthread_rwlock_t *) lock->storage);
+    if (error != 0) {
+        TRACE_ERROR(strerror(error));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool UnlockSharedRwLock(SharedRwLock *lock) {
+    int error = pthread_rwlock_unlock((pthread_rwlock_t *) lock->storage);
+    if (error != 0) {
+        TRACE_ERROR(strerror(error));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#endif
+
+#include <sched.h>
+
+void FullMemoryBarrier() {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+// Sleeps while word holds value. Linux futexes work across processes as long
+// as the word is in shared memory; elsewhere this polls.
+void WaitOnWord(volatile Uint32 *word, Uint32 value) {
+#if defined(__linux__)
+    syscall(SYS_futex, word, FUTEX_WAIT, value, NULL, NULL, 0);
+#else
+    while (*word == value) {
+        sched_yield();
+    }
+#endif
+}
+
+void WakeWord(volatile Uint32 *word) {
+#if defined(__linux__)
+    syscall(SYS_futex, word, FUTEX_WAKE, 1, NULL, NULL, 0);
+#endif
+}
+
+#if defined(__linux__)
+
+#include <sys/socket.h>
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#define F_GET_SEALS 1034
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#define F_SEAL_WRITE 0x0008
+#endif
+
+#define SEALS_READONLY (F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE)
+
+Bool AllocSealable(Uint64 size, Bytes *bytes, Int64 *handle) {
+    int fd = (int) syscall(SYS_memfd_create, "os.h", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    if (ftruncate(fd, (off_t) size) == -1) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+
+    void *base = mmap(
+        NULL,
+        (size_t) size,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        fd,
+        0
+    );
+    if (base == MAP_FAILED) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+
+    bytes->size = size;
+    bytes->base = (Uint8*) base;
+    *handle = fd;
+
+    return TRUE;
+}
+
+// The kernel refuses a write seal while writable shared mappings exist, so the
+// read-write mapping is replaced by a readonly one. If sealing fails, for
+// instance because another process still maps the file writable, the bytes are
+// mapped read-write again; if that fails too they are left empty, and the
+// contents stay reachable through the handle.
+Bool SealBytes(Bytes *bytes, Int64 handle) {
+    Uint64 size = bytes->size;
+    if (munmap((void *) bytes->base, (size_t) size) == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+    bytes->size = 0;
+    bytes->base = NULL;
+
+    if (fcntl((int) handle, F_ADD_SEALS, SEALS_READONLY) == -1) {
+        TRACE_ERROR(strerror(errno));
+
+        void *base = mmap(
+            NULL,
+            (size_t) size,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED,
+            (int) handle,
+            0
+        );
+        if (base == MAP_FAILED) {
+            TRACE_ERROR(strerror(errno));
+            return FALSE;
+        }
+
+        bytes->size = size;
+        bytes->base = (Uint8*) base;
+        return FALSE;
+    }
+
+    return MapSealedHandle(handle, bytes);
+}
+
+// Receivers must not trust the sender, so the seals are checked before mapping:
+// once present they guarantee the contents and size can never change.
+Bool MapSealedHandle(Int64 handle, Bytes *bytes) {
+    int seals = fcntl((int) handle, F_GET_SEALS);
+    if (seals == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+    if ((seals & SEALS_READONLY) != SEALS_READONLY) {
+        TRACE_ERROR("Memory file is not sealed");
+        return FALSE;
+    }
+
+    struct stat st;
+    if (fstat((int) handle, &st) == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+    if (st.st_size == 0) {
+        bytes->size = 0;
+        bytes->base = NULL;
+        return TRUE;
+    }
+
+    void *base = mmap(
+        NULL,
+        (size_t) st.st_size,
+        PROT_READ,
+        MAP_SHARED,
+        (int) handle,
+        0
+    );
+    if (base == MAP_FAILED) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    bytes->size = (Uint64) st.st_size;
+    bytes->base = (Uint8*) base;
+
+    return TRUE;
+}
+
+Bool SendHandle(Int64 socket, Int64 handle) {
+    int fd = (int) handle;
+    char byte = 0;
+    struct iovec iov = {&byte, 1};
+
+    union {
+        struct cmsghdr header;
+        char buffer[CMSG_SPACE(sizeof(int))];
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+
+    struct cmsghdr *header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(header), &fd, sizeof(int));
+
+    while (sendmsg((int) socket, &message, 0) == -1) {
+        if (errno != EINTR) {
+            TRACE_ERROR(strerror(errno));
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+Bool ReceiveHandle(Int64 socket, Int64 *handle) {
+    char byte;
+    struct iovec iov = {&byte, 1};
+
+    union {
+        struct cmsghdr header;
+        char buffer[CMSG_SPACE(sizeof(int))];
+    } control;
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+
+    while (recvmsg((int) socket, &message, MSG_CMSG_CLOEXEC) == -1) {
+        if (errno != EINTR) {
+            TRACE_ERROR(strerror(errno));
+            return FALSE;
+        }
+    }
+
+    // The peer is not trusted, so anything but exactly one complete handle is
+    // refused, closing whatever handles did arrive. A truncated control message
+    // means the kernel dropped part of what was sent.
+    struct cmsghdr *header = CMSG_FIRSTHDR(&message);
+    Bool rights = header != NULL && header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS &&
+        header->cmsg_len >= CMSG_LEN(0);
+    Uint64 received = rights ? (header->cmsg_len - CMSG_LEN(0)) / sizeof(int) : 0;
+    if (received != 1 || header->cmsg_len != CMSG_LEN(sizeof(int)) || (message.msg_flags & MSG_CTRUNC) != 0) {
+        for (Uint64 i = 0; i < received; ++i) {
+            int fd;
+            memcpy(&fd, CMSG_DATA(header) + i * sizeof(int), sizeof(int));
+            close(fd);
+        }
+        TRACE_ERROR("Message did not carry exactly one handle");
+        return FALSE;
+    }
+
+    int fd;
+    memcpy(&fd, CMSG_DATA(header), sizeof(int));
+    *handle = fd;
+
+    return TRUE;
+}
+
+#else
+
+Bool AllocSealable(Uint64 size, Bytes *bytes, Int64 *handle) {
+    TRACE_ERROR("Sealed memory files are only supported on Linux");
+    return FALSE;
+}
+
+Bool SealBytes(Bytes *bytes, Int64 handle) {
+    TRACE_ERROR("Sealed memory files are only supported on Linux");
+    return FALSE;
+}
+
+Bool MapSealedHandle(Int64 handle, Bytes *bytes) {
+    TRACE_ERROR("Sealed memory files are only supported on Linux");
+    return FALSE;
+}
+
+Bool SendHandle(Int64 socket, Int64 handle) {
+    TRACE_ERROR("Sealed memory files are only supported on Linux");
+    return FALSE;
+}
+
+Bool ReceiveHandle(Int64 socket, Int64 *handle) {
+    TRACE_ERROR("Sealed memory files are only supported on Linux");
+    return FALSE;
+}
+
+#endif
+
+Bool CloseFileHandle(Int64 handle) {
+    if (close((int) handle) == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+#if defined(__linux__)
+
+#ifndef MADV_MERGEABLE
+#define MADV_MERGEABLE 12
+#endif
+
+// Merging only happens while KSM runs, which is enabled by writing 1 to
+// /sys/kernel/mm/ksm/run.
+Bool MarkMergeable(Bytes bytes) {
+    if (bytes.size == 0) {
+        return TRUE;
+    }
+
+    size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    size_t delta = (size_t) bytes.base % pageSize;
+
+    if (madvise((void *) (bytes.base - delta), (size_t) bytes.size + delta, MADV_MERGEABLE) == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool ReadUint64File(const char *filePath, Uint64 *value) {
+    int fd = open(
+        filePath,
+        O_RDONLY
+    );
+    if (fd == -1) {
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    Uint8 buffer[32];
+    ssize_t size = read(fd, buffer, sizeof(buffer));
+    if (size == -1) {
+        TRACE_ERROR(strerror(errno));
+        close(fd);
+        return FALSE;
+    }
+
+    close(fd);
+
+    while (size > 0 && (buffer[size - 1] == '\n' || buffer[size - 1] == ' ')) {
+        size -= 1;
+    }
+
+    Bytes bytes = {buffer, (Uint64) size};
+
+    return ParseUint64(bytes, value);
+}
+
+// Counts are in pages. ksm_merging_pages needs Linux 6.1, so older kernels
+// report 0 for the process; pages_sharing is how many page mappings share an
+// already merged page, i.e. the pages saved.
+Bool GetMergedMemory(Uint64 *processBytes, Uint64 *systemBytes) {
+    Uint64 pageSize = (Uint64) sysconf(_SC_PAGESIZE);
+
+    Uint64 processPages = 0;
+    if (access("/proc/self/ksm_merging_pages", R_OK) == 0 &&
+        !ReadUint64File("/proc/self/ksm_merging_pages", &processPages)) {
+        return FALSE;
+    }
+
+    Uint64 systemPages;
+    if (!ReadUint64File("/sys/kernel/mm/ksm/pages_sharing", &systemPages)) {
+        return FALSE;
+    }
+
+    *processBytes = processPages * pageSize;
+    *systemBytes = systemPages * pageSize;
+
+    return TRUE;
+}
+
+#else
+
+Bool MarkMergeable(Bytes bytes) {
+    return TRUE;
+}
+
+Bool GetMergedMemory(Uint64 *processBytes, Uint64 *systemBytes) {
+    TRACE_ERROR("Merged memory statistics are only supported on Linux");
+    return FALSE;
+}
+
+#endif
+
+#include <stdio.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+Int64 MinorFaults() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == -1) {
+        return 0;
+    }
+
+    return (Int64) usage.ru_minflt;
+}
+
+// Runs in the forked child, so it only makes async-signal-safe calls.
+Bool WriteSnapshot(const char *temporaryPath, const char *filePath, const char *directoryPath, const Bytes *regions, Uint64 regionCount) {
+    int fd = open(
+        temporaryPath,
+        O_WRONLY | O_CREAT | O_TRUNC,
+        0644
+    );
+    if (fd == -1) {
+        return FALSE;
+    }
+
+    for (Uint64 i = 0; i < regionCount; ++i) {
+        Uint8 *base = regions[i].base;
+        Uint64 size = regions[i].size;
+        while (size > 0) {
+            size_t chunk = size > 0x40000000 ? 0x40000000 : (size_t) size;
+            ssize_t written = write(fd, base, chunk);
+            if (written == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                close(fd);
+                return FALSE;
+            }
+
+            base += written;
+            size -= (Uint64) written;
+        }
+    }
+
+    if (fsync(fd) == -1) {
+        close(fd);
+        return FALSE;
+    }
+    close(fd);
+
+    if (rename(temporaryPath, filePath) == -1) {
+        return FALSE;
+    }
+
+    // The rename is only durable once the directory entry is on disk.
+    int directory = open(directoryPath, O_RDONLY);
+    if (directory == -1) {
+        return FALSE;
+    }
+
+    Bool synced = fsync(directory) == 0;
+    close(directory);
+
+    return synced;
+}
+
+// The child writes the regions to filePath.tmp and renames it over filePath,
+// so the file is either the previous snapshot or the complete new one. The
+// parent keeps running; pages it modifies meanwhile are copied by the kernel.
+Bool StartSnapshot(const char *filePath, const Bytes *regions, Uint64 regionCount, Snapshot *snapshot) {
+    char temporaryPath[4096];
+    if (snprintf(temporaryPath, sizeof(temporaryPath), "%s.tmp", filePath) >= (int) sizeof(temporaryPath)) {
+        TRACE_ERROR("Snapshot file path is too long");
+        return FALSE;
+    }
+
+    char directoryPath[4096];
+    const char *slash = strrchr(filePath, '/');
+    if (slash == NULL) {
+        strcpy(directoryPath, ".");
+    } else if (slash == filePath) {
+        strcpy(directoryPath, "/");
+    } else {
+        memcpy(directoryPath, filePath, (size_t) (slash - filePath));
+        directoryPath[slash - filePath] = '\0';
+    }
+
+    // Close-on-exec keeps the write end out of programs the parent execs
+    // concurrently, which would otherwise hold WaitSnapshot's read open.
+    int fds[2];
+#if defined(__linux__)
+    if (syscall(SYS_pipe2, fds, O_CLOEXEC) == -1) {
+#else
+    if (pipe2(fds, O_CLOEXEC) == -1) {
+#endif
+        TRACE_ERROR(strerror(errno));
+        return FALSE;
+    }
+
+    Int64 faults = MinorFaults();
+
+    pid_t pid = fork();
+    if (pid == -1) {
+        TRACE_ERROR(strerror(errno));
+        close(fds[0]);
+        close(fds[1]);
+        return FALSE;
+    }
+
+    if (pid == 0) {
+        close(fds[0]);
+        Uint8 status = (Uint8) WriteSnapshot(temporaryPath, filePath, directoryPath, regions, regionCount);
+        while (write(fds[1], &status, 1) == -1 && errno == EINTR) {
+        }
+        _exit(status ? 0 : 1);
+    }
+
+    close(fds[1]);
+
+    snapshot->process = pid;
+    snapshot->pipe = fds[0];
+    snapshot->faults = faults;
+
+    return TRUE;
+}
+
+// copiedPages is the number of minor page faults the parent took while the
+// snapshot ran, which counts copy-on-write copies along with any other minor
+// faults such as first touches of new memory.
+Bool WaitSnapshot(Snapshot *snapshot, Uint64 *copiedPages) {
+    Uint8 status = 0;
+    ssize_t size;
+    do {
+        size = read((int) snapshot->pipe, &status, 1);
+    } while (size == -1 && errno == EINTR);
+    close((int) snapshot->pipe);
+
+    Int64 faults = MinorFaults() - snapshot->faults;
+    *copiedPages = faults > 0 ? (Uint64) faults : 0;
+
+    int childStatus;
+    while (waitpid((pid_t) snapshot->process, &childStatus, 0) == -1) {
+        if (errno != EINTR) {
+            TRACE_ERROR(strerror(errno));
+            return FALSE;
+        }
+    }
+
+    if (size != 1 || status != 1) {
+        TRACE_ERROR("Could not write the snapshot");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+Uint64 LoadLittleEndian64(const Uint8 *bytes) {
+    return
+        ((Uint64) bytes[0]) |
+        ((Uint64) bytes[1] << 8) |
+        ((Uint64) bytes[2] << 16) |
+        ((Uint64) bytes[3] << 24) |
+        ((Uint64) bytes[4] << 32) |
+        ((Uint64) bytes[5] << 40) |
+        ((Uint64) bytes[6] << 48) |
+        ((Uint64) bytes[7] << 56);
+}
+
+Bool ParseEightDigits(const Uint8 *digits, Uint64 *value) {
+    Uint64 chunk = LoadLittleEndian64(digits);
+
+    Uint64 high = chunk & 0xF0F0F0F0F0F0F0F0ull;
+    Uint64 carry = ((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4;
+    if ((high | carry) != 0x3333333333333333ull) {
+        return FALSE;
+    }
+
+    chunk = ((chunk & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+    chunk = ((chunk & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+    *value = ((chunk & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+
+    return TRUE;
+}
+
+Bool ParseDigits(const Uint8 *digits, Uint64 count, Uint64 *value) {
+    if (count == 0) {
+        return FALSE;
+    }
+
+    Uint64 result = 0;
+    Uint64 i = 0;
+    for (; i + 8 <= count; i += 8) {
+        Uint64 chunk;
+        if (!ParseEightDigits(digits + i, &chunk)) {
+            return FALSE;
+        }
+        if (result > (0xFFFFFFFFFFFFFFFFull - chunk) / 100000000) {
+            return FALSE;
+        }
+        result = result * 100000000 + chunk;
+    }
+    for (; i < count; ++i) {
+        Uint8 digit = (Uint8) (digits[i] - '0');
+        if (digit > 9) {
+            return FALSE;
+        }
+        if (result > (0xFFFFFFFFFFFFFFFFull - digit) / 10) {
+            return FALSE;
+        }
+        result = result * 10 + digit;
+    }
+
+    *value = result;
+
+    return TRUE;
+}
+
+Bool ParseUint64(Bytes bytes, Uint64 *value) {
+    if (!ParseDigits(bytes.base, bytes.size, value)) {
+        TRACE_ERROR("Could not parse an unsigned integer");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool ParseInt64(Bytes bytes, Int64 *value) {
+    Bool negative = FALSE;
+    Uint64 offset = 0;
+    if (bytes.size > 0 && (bytes.base[0] == '-' || bytes.base[0] == '+')) {
+        negative = bytes.base[0] == '-';
+        offset = 1;
+    }
+
+    Uint64 magnitude;
+    if (!ParseDigits(bytes.base + offset, bytes.size - offset, &magnitude)) {
+        TRACE_ERROR("Could not parse a signed integer");
+        return FALSE;
+    }
+
+    Uint64 limit = negative ? 0x8000000000000000ull : 0x7FFFFFFFFFFFFFFFull;
+    if (magnitude > limit) {
+        TRACE_ERROR("Could not parse a signed integer");
+        return FALSE;
+    }
+
+    *value = negative ? (Int64) (0 - magnitude) : (Int64) magnitude;
+
+    return TRUE;
+}
+
+// Powers of ten that are exactly representable as a Float64.
+static const Float64 exactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// High and low halves of 10^q for q in [-342, 324], normalized so the top bit is
+// set. Entries for -27 <= q < 0 are rounded up and those for 0 <= q <= 55 are
+// exact; all others are truncated.
+static const Uint64 powersOfTen128[667 * 2] = {
+    0xEEF453D6923BD65Aull, 0x113FAA2906A13B3Full, 0x9558B4661B6565F8ull, 0x4AC7CA59A424C507ull,
+    0xBAAEE17FA23EBF76ull, 0x5D79BCF00D2DF649ull, 0xE95A99DF8ACE6F53ull, 0xF4D82C2C107973DCull,
+    0x91D8A02BB6C10594ull, 0x79071B9B8A4BE869ull, 0xB64EC836A47146F9ull, 0x9748E2826CDEE284ull,
+    0xE3E27A444D8D98B7ull, 0xFD1B1B2308169B25ull, 0x8E6D8C6AB0787F72ull, 0xFE30F0F5E50E20F7ull,
+    0xB208EF855C969F4Full, 0xBDBD2D335E51A935ull, 0xDE8B2B66B3BC4723ull, 0xAD2C788035E61382ull,
+    0x8B16FB203055AC76ull, 0x4C3BCB5021AFCC31ull, 0xADDCB9E83C6B1793ull, 0xDF4ABE242A1BBF3Dull,
+    0xD953E8624B85DD78ull, 0xD71D6DAD34A2AF0Dull, 0x87D4713D6F33AA6Bull, 0x8672648C40E5AD68ull,
+    0xA9C98D8CCB009506ull, 0x680EFDAF511F18C2ull, 0xD43BF0EFFDC0BA48ull, 0x0212BD1B2566DEF2ull,
+    0x84A57695FE98746Dull, 0x014BB630F7604B57ull, 0xA5CED43B7E3E9188ull, 0x419EA3BD35385E2Dull,
+    0xCF42894A5DCE35EAull, 0x52064CAC828675B9ull, 0x818995CE7AA0E1B2ull, 0x7343EFEBD1940993ull,
+    0xA1EBFB4219491A1Full, 0x1014EBE6C5F90BF8ull, 0xCA66FA129F9B60A6ull, 0xD41A26E077774EF6ull,
+    0xFD00B897478238D0ull, 0x8920B098955522B4ull, 0x9E20735E8CB16382ull, 0x55B46E5F5D5535B0ull,
+    0xC5A890362FDDBC62ull, 0xEB2189F734AA831Dull, 0xF712B443BBD52B7Bull, 0xA5E9EC7501D523E4ull,
+    0x9A6BB0AA55653B2Dull, 0x47B233C92125366Eull, 0xC1069CD4EABE89F8ull, 0x999EC0BB696E840Aull,
+    0xF148440A256E2C76ull, 0xC00670EA43CA250Dull, 0x96CD2A865764DBCAull, 0x380406926A5E5728ull,
+    0xBC807527ED3E12BCull, 0xC605083704F5ECF2ull, 0xEBA09271E88D976Bull, 0xF7864A44C633682Eull,
+    0x93445B8731587EA3ull, 0x7AB3EE6AFBE0211Dull, 0xB8157268FDAE9E4Cull, 0x5960EA05BAD82964ull,
+    0xE61ACF033D1A45DFull, 0x6FB92487298E33BDull, 0x8FD0C16206306BABull, 0xA5D3B6D479F8E056ull,
+    0xB3C4F1BA87BC8696ull, 0x8F48A4899877186Cull, 0xE0B62E2929ABA83Cull, 0x331ACDABFE94DE87ull,
+    0x8C71DCD9BA0B4925ull, 0x9FF0C08B7F1D0B14ull, 0xAF8E5410288E1B6Full, 0x07ECF0AE5EE44DD9ull,
+    0xDB71E91432B1A24Aull, 0xC9E82CD9F69D6150ull, 0x892731AC9FAF056Eull, 0xBE311C083A225CD2ull,
+    0xAB70FE17C79AC6CAull, 0x6DBD630A48AAF406ull, 0xD64D3D9DB981787Dull, 0x092CBBCCDAD5B108ull,
+    0x85F0468293F0EB4Eull, 0x25BBF56008C58EA5ull, 0xA76C582338ED2621ull, 0xAF2AF2B80AF6F24Eull,
+    0xD1476E2C07286FAAull, 0x1AF5AF660DB4AEE1ull, 0x82CCA4DB847945CAull, 0x50D98D9FC890ED4Dull,
+    0xA37FCE126597973Cull, 0xE50FF107BAB528A0ull, 0xCC5FC196FEFD7D0Cull, 0x1E53ED49A96272C8ull,
+    0xFF77B1FCBEBCDC4Full, 0x25E8E89C13BB0F7Aull, 0x9FAACF3DF73609B1ull, 0x77B191618C54E9ACull,
+    0xC795830D75038C1Dull, 0xD59DF5B9EF6A2417ull, 0xF97AE3D0D2446F25ull, 0x4B0573286B44AD1Dull,
+    0x9BECCE62836AC577ull, 0x4EE367F9430AEC32ull, 0xC2E801FB244576D5ull, 0x229C41F793CDA73Full,
+    0xF3A20279ED56D48Aull, 0x6B43527578C1110Full, 0x9845418C345644D6ull, 0x830A13896B78AAA9ull,
+    0xBE5691EF416BD60Cull, 0x23CC986BC656D553ull, 0xEDEC366B11C6CB8Full, 0x2CBFBE86B7EC8AA8ull,
+    0x94B3A202EB1C3F39ull, 0x7BF7D71432F3D6A9ull, 0xB9E08A83A5E34F07ull, 0xDAF5CCD93FB0CC53ull,
+    0xE858AD248F5C22C9ull, 0xD1B3400F8F9CFF68ull, 0x91376C36D99995BEull, 0x23100809B9C21FA1ull,
+    0xB58547448FFFFB2Dull, 0xABD40A0C2832A78Aull, 0xE2E69915B3FFF9F9ull, 0x16C90C8F323F516Cull,
+    0x8DD01FAD907FFC3Bull, 0xAE3DA7D97F6792E3ull, 0xB1442798F49FFB4Aull, 0x99CD11CFDF41779Cull,
+    0xDD95317F31C7FA1Dull, 0x40405643D711D583ull, 0x8A7D3EEF7F1CFC52ull, 0x482835EA666B2572ull,
+    0xAD1C8EAB5EE43B66ull, 0xDA3243650005EECFull, 0xD863B256369D4A40ull, 0x90BED43E40076A82ull,
+    0x873E4F75E2224E68ull, 0x5A7744A6E804A291ull, 0xA90DE3535AAAE202ull, 0x711515D0A205CB36ull,
+    0xD3515C2831559A83ull, 0x0D5A5B44CA873E03ull, 0x8412D9991ED58091ull, 0xE858790AFE9486C2ull,
+    0xA5178FFF668AE0B6ull, 0x626E974DBE39A872ull, 0xCE5D73FF402D98E3ull, 0xFB0A3D212DC8128Full,
+    0x80FA687F881C7F8Eull, 0x7CE66634BC9D0B99ull, 0xA139029F6A239F72ull, 0x1C1FFFC1EBC44E80ull,
+    0xC987434744AC874Eull, 0xA327FFB266B56220ull, 0xFBE9141915D7A922ull, 0x4BF1FF9F0062BAA8ull,
+    0x9D71AC8FADA6C9B5ull, 0x6F773FC3603DB4A9ull, 0xC4CE17B399107C22ull, 0xCB550FB4384D21D3ull,
+    0xF6019DA07F549B2Bull, 0x7E2A53A146606A48ull, 0x99C102844F94E0FBull, 0x2EDA7444CBFC426Dull,
+    0xC0314325637A1939ull, 0xFA911155FEFB5308ull, 0xF03D93EEBC589F88ull, 0x793555AB7EBA27CAull,
+    0x96267C7535B763B5ull, 0x4BC1558B2F3458DEull, 0xBBB01B9283253CA2ull, 0x9EB1AAEDFB016F16ull,
+    0xEA9C227723EE8BCBull, 0x465E15A979C1CADCull, 0x92A1958A7675175Full, 0x0BFACD89EC191EC9ull,
+    0xB749FAED14125D36ull, 0xCEF980EC671F667Bull, 0xE51C79A85916F484ull, 0x82B7E12780E7401Aull,
+    0x8F31CC0937AE58D2ull, 0xD1B2ECB8B0908810ull, 0xB2FE3F0B8599EF07ull, 0x861FA7E6DCB4AA15ull,
+    0xDFBDCECE67006AC9ull, 0x67A791E093E1D49Aull, 0x8BD6A141006042BDull, 0xE0C8BB2C5C6D24E0ull,
+    0xAECC49914078536Dull, 0x58FAE9F773886E18ull, 0xDA7F5BF590966848ull, 0xAF39A475506A899Eull,
+    0x888F99797A5E012Dull, 0x6D8406C952429603ull, 0xAAB37FD7D8F58178ull, 0xC8E5087BA6D33B83ull,
+    0xD5605FCDCF32E1D6ull, 0xFB1E4A9A90880A64ull, 0x855C3BE0A17FCD26ull, 0x5CF2EEA09A55067Full,
+    0xA6B34AD8C9DFC06Full, 0xF42FAA48C0EA481Eull, 0xD0601D8EFC57B08Bull, 0xF13B94DAF124DA26ull,
+    0x823C12795DB6CE57ull, 0x76C53D08D6B70858ull, 0xA2CB1717B52481EDull, 0x54768C4B0C64CA6Eull,
+    0xCB7DDCDDA26DA268ull, 0xA9942F5DCF7DFD09ull, 0xFE5D54150B090B02ull, 0xD3F93B35435D7C4Cull,
+    0x9EFA548D26E5A6E1ull, 0xC47BC5014A1A6DAFull, 0xC6B8E9B0709F109Aull, 0x359AB6419CA1091Bull,
+    0xF867241C8CC6D4C0ull, 0xC30163D203C94B62ull, 0x9B407691D7FC44F8ull, 0x79E0DE63425DCF1Dull,
+    0xC21094364DFB5636ull, 0x985915FC12F542E4ull, 0xF294B943E17A2BC4ull, 0x3E6F5B7B17B2939Dull,
+    0x979CF3CA6CEC5B5Aull, 0xA705992CEECF9C42ull, 0xBD8430BD08277231ull, 0x50C6FF782A838353ull,
+    0xECE53CEC4A314EBDull, 0xA4F8BF5635246428ull, 0x940F4613AE5ED136ull, 0x871B7795E136BE99ull,
+    0xB913179899F68584ull, 0x28E2557B59846E3Full, 0xE757DD7EC07426E5ull, 0x331AEADA2FE589CFull,
+    0x9096EA6F3848984Full, 0x3FF0D2C85DEF7621ull, 0xB4BCA50B065ABE63ull, 0x0FED077A756B53A9ull,
+    0xE1EBCE4DC7F16DFBull, 0xD3E8495912C62894ull, 0x8D3360F09CF6E4BDull, 0x64712DD7ABBBD95Cull,
+    0xB080392CC4349DECull, 0xBD8D794D96AACFB3ull, 0xDCA04777F541C567ull, 0xECF0D7A0FC5583A0ull,
+    0x89E42CAAF9491B60ull, 0xF41686C49DB57244ull, 0xAC5D37D5B79B6239ull, 0x311C2875C522CED5ull,
+    0xD77485CB25823AC7ull, 0x7D633293366B828Bull, 0x86A8D39EF77164BCull, 0xAE5DFF9C02033197ull,
+    0xA8530886B54DBDEBull, 0xD9F57F830283FDFCull, 0xD267CAA862A12D66ull, 0xD072DF63C324FD7Bull,
+    0x8380DEA93DA4BC60ull, 0x4247CB9E59F71E6Dull, 0xA46116538D0DEB78ull, 0x52D9BE85F074E608ull,
+    0xCD795BE870516656ull, 0x67902E276C921F8Bull, 0x806BD9714632DFF6ull, 0x00BA1CD8A3DB53B6ull,
+    0xA086CFCD97BF97F3ull, 0x80E8A40ECCD228A4ull, 0xC8A883C0FDAF7DF0ull, 0x6122CD128006B2CDull,
+    0xFAD2A4B13D1B5D6Cull, 0x796B805720085F81ull, 0x9CC3A6EEC6311A63ull, 0xCBE3303674053BB0ull,
+    0xC3F490AA77BD60FCull, 0xBEDBFC4411068A9Cull, 0xF4F1B4D515ACB93Bull, 0xEE92FB5515482D44ull,
+    0x991711052D8BF3C5ull, 0x751BDD152D4D1C4Aull, 0xBF5CD54678EEF0B6ull, 0xD262D45A78A0635Dull,
+    0xEF340A98172AACE4ull, 0x86FB897116C87C34ull, 0x9580869F0E7AAC0Eull, 0xD45D35E6AE3D4DA0ull,
+    0xBAE0A846D2195712ull, 0x8974836059CCA109ull, 0xE998D258869FACD7ull, 0x2BD1A438703FC94Bull,
+    0x91FF83775423CC06ull, 0x7B6306A34627DDCFull, 0xB67F6455292CBF08ull, 0x1A3BC84C17B1D542ull,
+    0xE41F3D6A7377EECAull, 0x20CABA5F1D9E4A93ull, 0x8E938662882AF53Eull, 0x547EB47B7282EE9Cull,
+    0xB23867FB2A35B28Dull, 0xE99E619A4F23AA43ull, 0xDEC681F9F4C31F31ull, 0x6405FA00E2EC94D4ull,
+    0x8B3C113C38F9F37Eull, 0xDE83BC408DD3DD04ull, 0xAE0B158B4738705Eull, 0x9624AB50B148D445ull,
+    0xD98DDAEE19068C76ull, 0x3BADD624DD9B0957ull, 0x87F8A8D4CFA417C9ull, 0xE54CA5D70A80E5D6ull,
+    0xA9F6D30A038D1DBCull, 0x5E9FCF4CCD211F4Cull, 0xD47487CC8470652Bull, 0x7647C3200069671Full,
+    0x84C8D4DFD2C63F3Bull, 0x29ECD9F40041E073ull, 0xA5FB0A17C777CF09ull, 0xF468107100525890ull,
+    0xCF79CC9DB955C2CCull, 0x7182148D4066EEB4ull, 0x81AC1FE293D599BFull, 0xC6F14CD848405530ull,
+    0xA21727DB38CB002Full, 0xB8ADA00E5A506A7Cull, 0xCA9CF1D206FDC03Bull, 0xA6D90811F0E4851Cull,
+    0xFD442E4688BD304Aull, 0x908F4A166D1DA663ull, 0x9E4A9CEC15763E2Eull, 0x9A598E4E043287FEull,
+    0xC5DD44271AD3CDBAull, 0x40EFF1E1853F29FDull, 0xF7549530E188C128ull, 0xD12BEE59E68EF47Cull,
+    0x9A94DD3E8CF578B9ull, 0x82BB74F8301958CEull, 0xC13A148E3032D6E7ull, 0xE36A52363C1FAF01ull,
+    0xF18899B1BC3F8CA1ull, 0xDC44E6C3CB279AC1ull, 0x96F5600F15A7B7E5ull, 0x29AB103A5EF8C0B9ull,
+    0xBCB2B812DB11A5DEull, 0x7415D448F6B6F0E7ull, 0xEBDF661791D60F56ull, 0x111B495B3464AD21ull,
+    0x936B9FCEBB25C995ull, 0xCAB10DD900BEEC34ull, 0xB84687C269EF3BFBull, 0x3D5D514F40EEA742ull,
+    0xE65829B3046B0AFAull, 0x0CB4A5A3112A5112ull, 0x8FF71A0FE2C2E6DCull, 0x47F0E785EABA72ABull,
+    0xB3F4E093DB73A093ull, 0x59ED216765690F56ull, 0xE0F218B8D25088B8ull, 0x306869C13EC3532Cull,
+    0x8C974F7383725573ull, 0x1E414218C73A13FBull, 0xAFBD2350644EEACFull, 0xE5D1929EF90898FAull,
+    0xDBAC6C247D62A583ull, 0xDF45F746B74ABF39ull, 0x894BC396CE5DA772ull, 0x6B8BBA8C328EB783ull,
+    0xAB9EB47C81F5114Full, 0x066EA92F3F326564ull, 0xD686619BA27255A2ull, 0xC80A537B0EFEFEBDull,
+    0x8613FD0145877585ull, 0xBD06742CE95F5F36ull, 0xA798FC4196E952E7ull, 0x2C48113823B73704ull,
+    0xD17F3B51FCA3A7A0ull, 0xF75A15862CA504C5ull, 0x82EF85133DE648C4ull, 0x9A984D73DBE722FBull,
+    0xA3AB66580D5FDAF5ull, 0xC13E60D0D2E0EBBAull, 0xCC963FEE10B7D1B3ull, 0x318DF905079926A8ull,
+    0xFFBBCFE994E5C61Full, 0xFDF17746497F7052ull, 0x9FD561F1FD0F9BD3ull, 0xFEB6EA8BEDEFA633ull,
+    0xC7CABA6E7C5382C8ull, 0xFE64A52EE96B8FC0ull, 0xF9BD690A1B68637Bull, 0x3DFDCE7AA3C673B0ull,
+    0x9C1661A651213E2Dull, 0x06BEA10CA65C084Eull, 0xC31BFA0FE5698DB8ull, 0x486E494FCFF30A62ull,
+    0xF3E2F893DEC3F126ull, 0x5A89DBA3C3EFCCFAull, 0x986DDB5C6B3A76B7ull, 0xF89629465A75E01Cull,
+    0xBE89523386091465ull, 0xF6BBB397F1135823ull, 0xEE2BA6C0678B597Full, 0x746AA07DED582E2Cull,
+    0x94DB483840B717EFull, 0xA8C2A44EB4571CDCull, 0xBA121A4650E4DDEBull, 0x92F34D62616CE413ull,
+    0xE896A0D7E51E1566ull, 0x77B020BAF9C81D17ull, 0x915E2486EF32CD60ull, 0x0ACE1474DC1D122Eull,
+    0xB5B5ADA8AAFF80B8ull, 0x0D819992132456BAull, 0xE3231912D5BF60E6ull, 0x10E1FFF697ED6C69ull,
+    0x8DF5EFABC5979C8Full, 0xCA8D3FFA1EF463C1ull, 0xB1736B96B6FD83B3ull, 0xBD308FF8A6B17CB2ull,
+    0xDDD0467C64BCE4A0ull, 0xAC7CB3F6D05DDBDEull, 0x8AA22C0DBEF60EE4ull, 0x6BCDF07A423AA96Bull,
+    0xAD4AB7112EB3929Dull, 0x86C16C98D2C953C6ull, 0xD89D64D57A607744ull, 0xE871C7BF077BA8B7ull,
+    0x87625F056C7C4A8Bull, 0x11471CD764AD4972ull, 0xA93AF6C6C79B5D2Dull, 0xD598E40D3DD89BCFull,
+    0xD389B47879823479ull, 0x4AFF1D108D4EC2C3ull, 0x843610CB4BF160CBull, 0xCEDF722A585139BAull,
+    0xA54394FE1EEDB8FEull, 0xC2974EB4EE658828ull, 0xCE947A3DA6A9273Eull, 0x733D226229FEEA32ull,
+    0x811CCC668829B887ull, 0x0806357D5A3F525Full, 0xA163FF802A3426A8ull, 0xCA07C2DCB0CF26F7ull,
+    0xC9BCFF6034C13052ull, 0xFC89B393DD02F0B5ull, 0xFC2C3F3841F17C67ull, 0xBBAC2078D443ACE2ull,
+    0x9D9BA7832936EDC0ull, 0xD54B944B84AA4C0Dull, 0xC5029163F384A931ull, 0x0A9E795E65D4DF11ull,
+    0xF64335BCF065D37Dull, 0x4D4617B5FF4A16D5ull, 0x99EA0196163FA42Eull, 0x504BCED1BF8E4E45ull,
+    0xC06481FB9BCF8D39ull, 0xE45EC2862F71E1D6ull, 0xF07DA27A82C37088ull, 0x5D767327BB4E5A4Cull,
+    0x964E858C91BA2655ull, 0x3A6A07F8D510F86Full, 0xBBE226EFB628AFEAull, 0x890489F70A55368Bull,
+    0xEADAB0ABA3B2DBE5ull, 0x2B45AC74CCEA842Eull, 0x92C8AE6B464FC96Full, 0x3B0B8BC90012929Dull,
+    0xB77ADA0617E3BBCBull, 0x09CE6EBB40173744ull, 0xE55990879DDCAABDull, 0xCC420A6A101D0515ull,
+    0x8F57FA54C2A9EAB6ull, 0x9FA946824A12232Dull, 0xB32DF8E9F3546564ull, 0x47939822DC96ABF9ull,
+    0xDFF9772470297EBDull, 0x59787E2B93BC56F7ull, 0x8BFBEA76C619EF36ull, 0x57EB4EDB3C55B65Aull,
+    0xAEFAE51477A06B03ull, 0xEDE622920B6B23F1ull, 0xDAB99E59958885C4ull, 0xE95FAB368E45ECEDull,
+    0x88B402F7FD75539Bull, 0x11DBCB0218EBB414ull, 0xAAE103B5FCD2A881ull, 0xD652BDC29F26A119ull,
+    0xD59944A37C0752A2ull, 0x4BE76D3346F0495Full, 0x857FCAE62D8493A5ull, 0x6F70A4400C562DDBull,
+    0xA6DFBD9FB8E5B88Eull, 0xCB4CCD500F6BB952ull, 0xD097AD07A71F26B2ull, 0x7E2000A41346A7A7ull,
+    0x825ECC24C873782Full, 0x8ED400668C0C28C8ull, 0xA2F67F2DFA90563Bull, 0x728900802F0F32FAull,
+    0xCBB41EF979346BCAull, 0x4F2B40A03AD2FFB9ull, 0xFEA126B7D78186BCull, 0xE2F610C84987BFA8ull,
+    0x9F24B832E6B0F436ull, 0x0DD9CA7D2DF4D7C9ull, 0xC6EDE63FA05D3143ull, 0x91503D1C79720DBBull,
+    0xF8A95FCF88747D94ull, 0x75A44C6397CE912Aull, 0x9B69DBE1B548CE7Cull, 0xC986AFBE3EE11ABAull,
+    0xC24452DA229B021Bull, 0xFBE85BADCE996168ull, 0xF2D56790AB41C2A2ull, 0xFAE27299423FB9C3ull,
+    0x97C560BA6B0919A5ull, 0xDCCD879FC967D41Aull, 0xBDB6B8E905CB600Full, 0x5400E987BBC1C920ull,
+    0xED246723473E3813ull, 0x290123E9AAB23B68ull, 0x9436C0760C86E30Bull, 0xF9A0B6720AAF6521ull,
+    0xB94470938FA89BCEull, 0xF808E40E8D5B3E69ull, 0xE7958CB87392C2C2ull, 0xB60B1D1230B20E04ull,
+    0x90BD77F3483BB9B9ull, 0xB1C6F22B5E6F48C2ull, 0xB4ECD5F01A4AA828ull, 0x1E38AEB6360B1AF3ull,
+    0xE2280B6C20DD5232ull, 0x25C6DA63C38DE1B0ull, 0x8D590723948A535Full, 0x579C487E5A38AD0Eull,
+    0xB0AF48EC79ACE837ull, 0x2D835A9DF0C6D851ull, 0xDCDB1B2798182244ull, 0xF8E431456CF88E65ull,
+    0x8A08F0F8BF0F156Bull, 0x1B8E9ECB641B58FFull, 0xAC8B2D36EED2DAC5ull, 0xE272467E3D222F3Full,
+    0xD7ADF884AA879177ull, 0x5B0ED81DCC6ABB0Full, 0x86CCBB52EA94BAEAull, 0x98E947129FC2B4E9ull,
+    0xA87FEA27A539E9A5ull, 0x3F2398D747B36224ull, 0xD29FE4B18E88640Eull, 0x8EEC7F0D19A03AADull,
+    0x83A3EEEEF9153E89ull, 0x1953CF68300424ACull, 0xA48CEAAAB75A8E2Bull, 0x5FA8C3423C052DD7ull,
+    0xCDB02555653131B6ull, 0x3792F412CB06794Dull, 0x808E17555F3EBF11ull, 0xE2BBD88BBEE40BD0ull,
+    0xA0B19D2AB70E6ED6ull, 0x5B6ACEAEAE9D0EC4ull, 0xC8DE047564D20A8Bull, 0xF245825A5A445275ull,
+    0xFB158592BE068D2Eull, 0xEED6E2F0F0D56712ull, 0x9CED737BB6C4183Dull, 0x55464DD69685606Bull,
+    0xC428D05AA4751E4Cull, 0xAA97E14C3C26B886ull, 0xF53304714D9265DFull, 0xD53DD99F4B3066A8ull,
+    0x993FE2C6D07B7FABull, 0xE546A8038EFE4029ull, 0xBF8FDB78849A5F96ull, 0xDE98520472BDD033ull,
+    0xEF73D256A5C0F77Cull, 0x963E66858F6D4440ull, 0x95A8637627989AADull, 0xDDE7001379A44AA8ull,
+    0xBB127C53B17EC159ull, 0x5560C018580D5D52ull, 0xE9D71B689DDE71AFull, 0xAAB8F01E6E10B4A6ull,
+    0x9226712162AB070Dull, 0xCAB3961304CA70E8ull, 0xB6B00D69BB55C8D1ull, 0x3D607B97C5FD0D22ull,
+    0xE45C10C42A2B3B05ull, 0x8CB89A7DB77C506Aull, 0x8EB98A7A9A5B04E3ull, 0x77F3608E92ADB242ull,
+    0xB267ED1940F1C61Cull, 0x55F038B237591ED3ull, 0xDF01E85F912E37A3ull, 0x6B6C46DEC52F6688ull,
+    0x8B61313BBABCE2C6ull, 0x2323AC4B3B3DA015ull, 0xAE397D8AA96C1B77ull, 0xABEC975E0A0D081Aull,
+    0xD9C7DCED53C72255ull, 0x96E7BD358C904A21ull, 0x881CEA14545C7575ull, 0x7E50D64177DA2E54ull,
+    0xAA242499697392D2ull, 0xDDE50BD1D5D0B9E9ull, 0xD4AD2DBFC3D07787ull, 0x955E4EC64B44E864ull,
+    0x84EC3C97DA624AB4ull, 0xBD5AF13BEF0B113Eull, 0xA6274BBDD0FADD61ull, 0xECB1AD8AEACDD58Eull,
+    0xCFB11EAD453994BAull, 0x67DE18EDA5814AF2ull, 0x81CEB32C4B43FCF4ull, 0x80EACF948770CED7ull,
+    0xA2425FF75E14FC31ull, 0xA1258379A94D028Dull, 0xCAD2F7F5359A3B3Eull, 0x096EE45813A04330ull,
+    0xFD87B5F28300CA0Dull, 0x8BCA9D6E188853FCull, 0x9E74D1B791E07E48ull, 0x775EA264CF55347Eull,
+    0xC612062576589DDAull, 0x95364AFE032A819Eull, 0xF79687AED3EEC551ull, 0x3A83DDBD83F52205ull,
+    0x9ABE14CD44753B52ull, 0xC4926A9672793543ull, 0xC16D9A0095928A27ull, 0x75B7053C0F178294ull,
+    0xF1C90080BAF72CB1ull, 0x5324C68B12DD6339ull, 0x971DA05074DA7BEEull, 0xD3F6FC16EBCA5E04ull,
+    0xBCE5086492111AEAull, 0x88F4BB1CA6BCF585ull, 0xEC1E4A7DB69561A5ull, 0x2B31E9E3D06C32E6ull,
+    0x9392EE8E921D5D07ull, 0x3AFF322E62439FD0ull, 0xB877AA3236A4B449ull, 0x09BEFEB9FAD487C3ull,
+    0xE69594BEC44DE15Bull, 0x4C2EBE687989A9B4ull, 0x901D7CF73AB0ACD9ull, 0x0F9D37014BF60A11ull,
+    0xB424DC35095CD80Full, 0x538484C19EF38C95ull, 0xE12E13424BB40E13ull, 0x2865A5F206B06FBAull,
+    0x8CBCCC096F5088CBull, 0xF93F87B7442E45D4ull, 0xAFEBFF0BCB24AAFEull, 0xF78F69A51539D749ull,
+    0xDBE6FECEBDEDD5BEull, 0xB573440E5A884D1Cull, 0x89705F4136B4A597ull, 0x31680A88F8953031ull,
+    0xABCC77118461CEFCull, 0xFDC20D2B36BA7C3Eull, 0xD6BF94D5E57A42BCull, 0x3D32907604691B4Dull,
+    0x8637BD05AF6C69B5ull, 0xA63F9A49C2C1B110ull, 0xA7C5AC471B478423ull, 0x0FCF80DC33721D54ull,
+    0xD1B71758E219652Bull, 0xD3C36113404EA4A9ull, 0x83126E978D4FDF3Bull, 0x645A1CAC083126EAull,
+    0xA3D70A3D70A3D70Aull, 0x3D70A3D70A3D70A4ull, 0xCCCCCCCCCCCCCCCCull, 0xCCCCCCCCCCCCCCCDull,
+    0x8000000000000000ull, 0x0000000000000000ull, 0xA000000000000000ull, 0x0000000000000000ull,
+    0xC800000000000000ull, 0x0000000000000000ull, 0xFA00000000000000ull, 0x0000000000000000ull,
+    0x9C40000000000000ull, 0x0000000000000000ull, 0xC350000000000000ull, 0x0000000000000000ull,
+    0xF424000000000000ull, 0x0000000000000000ull, 0x9896800000000000ull, 0x0000000000000000ull,
+    0xBEBC200000000000ull, 0x0000000000000000ull, 0xEE6B280000000000ull, 0x0000000000000000ull,
+    0x9502F90000000000ull, 0x0000000000000000ull, 0xBA43B74000000000ull, 0x0000000000000000ull,
+    0xE8D4A51000000000ull, 0x0000000000000000ull, 0x9184E72A00000000ull, 0x0000000000000000ull,
+    0xB5E620F480000000ull, 0x0000000000000000ull, 0xE35FA931A0000000ull, 0x0000000000000000ull,
+    0x8E1BC9BF04000000ull, 0x0000000000000000ull, 0xB1A2BC2EC5000000ull, 0x0000000000000000ull,
+    0xDE0B6B3A76400000ull, 0x0000000000000000ull, 0x8AC7230489E80000ull, 0x0000000000000000ull,
+    0xAD78EBC5AC620000ull, 0x0000000000000000ull, 0xD8D726B7177A8000ull, 0x0000000000000000ull,
+    0x878678326EAC9000ull, 0x0000000000000000ull, 0xA968163F0A57B400ull, 0x0000000000000000ull,
+    0xD3C21BCECCEDA100ull, 0x0000000000000000ull, 0x84595161401484A0ull, 0x0000000000000000ull,
+    0xA56FA5B99019A5C8ull, 0x0000000000000000ull, 0xCECB8F27F4200F3Aull, 0x0000000000000000ull,
+    0x813F3978F8940984ull, 0x4000000000000000ull, 0xA18F07D736B90BE5ull, 0x5000000000000000ull,
+    0xC9F2C9CD04674EDEull, 0xA400000000000000ull, 0xFC6F7C4045812296ull, 0x4D00000000000000ull,
+    0x9DC5ADA82B70B59Dull, 0xF020000000000000ull, 0xC5371912364CE305ull, 0x6C28000000000000ull,
+    0xF684DF56C3E01BC6ull, 0xC732000000000000ull, 0x9A130B963A6C115Cull, 0x3C7F400000000000ull,
+    0xC097CE7BC90715B3ull, 0x4B9F100000000000ull, 0xF0BDC21ABB48DB20ull, 0x1E86D40000000000ull,
+    0x96769950B50D88F4ull, 0x1314448000000000ull, 0xBC143FA4E250EB31ull, 0x17D955A000000000ull,
+    0xEB194F8E1AE525FDull, 0x5DCFAB0800000000ull, 0x92EFD1B8D0CF37BEull, 0x5AA1CAE500000000ull,
+    0xB7ABC627050305ADull, 0xF14A3D9E40000000ull, 0xE596B7B0C643C719ull, 0x6D9CCD05D0000000ull,
+    0x8F7E32CE7BEA5C6Full, 0xE4820023A2000000ull, 0xB35DBF821AE4F38Bull, 0xDDA2802C8A800000ull,
+    0xE0352F62A19E306Eull, 0xD50B2037AD200000ull, 0x8C213D9DA502DE45ull, 0x4526F422CC340000ull,
+    0xAF298D050E4395D6ull, 0x9670B12B7F410000ull, 0xDAF3F04651D47B4Cull, 0x3C0CDD765F114000ull,
+    0x88D8762BF324CD0Full, 0xA5880A69FB6AC800ull, 0xAB0E93B6EFEE0053ull, 0x8EEA0D047A457A00ull,
+    0xD5D238A4ABE98068ull, 0x72A4904598D6D880ull, 0x85A36366EB71F041ull, 0x47A6DA2B7F864750ull,
+    0xA70C3C40A64E6C51ull, 0x999090B65F67D924ull, 0xD0CF4B50CFE20765ull, 0xFFF4B4E3F741CF6Dull,
+    0x82818F1281ED449Full, 0xBFF8F10E7A8921A4ull, 0xA321F2D7226895C7ull, 0xAFF72D52192B6A0Dull,
+    0xCBEA6F8CEB02BB39ull, 0x9BF4F8A69F764490ull, 0xFEE50B7025C36A08ull, 0x02F236D04753D5B4ull,
+    0x9F4F2726179A2245ull, 0x01D762422C946590ull, 0xC722F0EF9D80AAD6ull, 0x424D3AD2B7B97EF5ull,
+    0xF8EBAD2B84E0D58Bull, 0xD2E0898765A7DEB2ull, 0x9B934C3B330C8577ull, 0x63CC55F49F88EB2Full,
+    0xC2781F49FFCFA6D5ull, 0x3CBF6B71C76B25FBull, 0xF316271C7FC3908Aull, 0x8BEF464E3945EF7Aull,
+    0x97EDD871CFDA3A56ull, 0x97758BF0E3CBB5ACull, 0xBDE94E8E43D0C8ECull, 0x3D52EEED1CBEA317ull,
+    0xED63A231D4C4FB27ull, 0x4CA7AAA863EE4BDDull, 0x945E455F24FB1CF8ull, 0x8FE8CAA93E74EF6Aull,
+    0xB975D6B6EE39E436ull, 0xB3E2FD538E122B44ull, 0xE7D34C64A9C85D44ull, 0x60DBBCA87196B616ull,
+    0x90E40FBEEA1D3A4Aull, 0xBC8955E946FE31CDull, 0xB51D13AEA4A488DDull, 0x6BABAB6398BDBE41ull,
+    0xE264589A4DCDAB14ull, 0xC696963C7EED2DD1ull, 0x8D7EB76070A08AECull, 0xFC1E1DE5CF543CA2ull,
+    0xB0DE65388CC8ADA8ull, 0x3B25A55F43294BCBull, 0xDD15FE86AFFAD912ull, 0x49EF0EB713F39EBEull,
+    0x8A2DBF142DFCC7ABull, 0x6E3569326C784337ull, 0xACB92ED9397BF996ull, 0x49C2C37F07965404ull,
+    0xD7E77A8F87DAF7FBull, 0xDC33745EC97BE906ull, 0x86F0AC99B4E8DAFDull, 0x69A028BB3DED71A3ull,
+    0xA8ACD7C0222311BCull, 0xC40832EA0D68CE0Cull, 0xD2D80DB02AABD62Bull, 0xF50A3FA490C30190ull,
+    0x83C7088E1AAB65DBull, 0x792667C6DA79E0FAull, 0xA4B8CAB1A1563F52ull, 0x577001B891185938ull,
+    0xCDE6FD5E09ABCF26ull, 0xED4C0226B55E6F86ull, 0x80B05E5AC60B6178ull, 0x544F8158315B05B4ull,
+    0xA0DC75F1778E39D6ull, 0x696361AE3DB1C721ull, 0xC913936DD571C84Cull, 0x03BC3A19CD1E38E9ull,
+    0xFB5878494ACE3A5Full, 0x04AB48A04065C723ull, 0x9D174B2DCEC0E47Bull, 0x62EB0D64283F9C76ull,
+    0xC45D1DF942711D9Aull, 0x3BA5D0BD324F8394ull, 0xF5746577930D6500ull, 0xCA8F44EC7EE36479ull,
+    0x9968BF6ABBE85F20ull, 0x7E998B13CF4E1ECBull, 0xBFC2EF456AE276E8ull, 0x9E3FEDD8C321A67Eull,
+    0xEFB3AB16C59B14A2ull, 0xC5CFE94EF3EA101Eull, 0x95D04AEE3B80ECE5ull, 0xBBA1F1D158724A12ull,
+    0xBB445DA9CA61281Full, 0x2A8A6E45AE8EDC97ull, 0xEA1575143CF97226ull, 0xF52D09D71A3293BDull,
+    0x924D692CA61BE758ull, 0x593C2626705F9C56ull, 0xB6E0C377CFA2E12Eull, 0x6F8B2FB00C77836Cull,
+    0xE498F455C38B997Aull, 0x0B6DFB9C0F956447ull, 0x8EDF98B59A373FECull, 0x4724BD4189BD5EACull,
+    0xB2977EE300C50FE7ull, 0x58EDEC91EC2CB657ull, 0xDF3D5E9BC0F653E1ull, 0x2F2967B66737E3EDull,
+    0x8B865B215899F46Cull, 0xBD79E0D20082EE74ull, 0xAE67F1E9AEC07187ull, 0xECD8590680A3AA11ull,
+    0xDA01EE641A708DE9ull, 0xE80E6F4820CC9495ull, 0x884134FE908658B2ull, 0x3109058D147FDCDDull,
+    0xAA51823E34A7EEDEull, 0xBD4B46F0599FD415ull, 0xD4E5E2CDC1D1EA96ull, 0x6C9E18AC7007C91Aull,
+    0x850FADC09923329Eull, 0x03E2CF6BC604DDB0ull, 0xA6539930BF6BFF45ull, 0x84DB8346B786151Cull,
+    0xCFE87F7CEF46FF16ull, 0xE612641865679A63ull, 0x81F14FAE158C5F6Eull, 0x4FCB7E8F3F60C07Eull,
+    0xA26DA3999AEF7749ull, 0xE3BE5E330F38F09Dull, 0xCB090C8001AB551Cull, 0x5CADF5BFD3072CC5ull,
+    0xFDCB4FA002162A63ull, 0x73D9732FC7C8F7F6ull, 0x9E9F11C4014DDA7Eull, 0x2867E7FDDCDD9AFAull,
+    0xC646D63501A1511Dull, 0xB281E1FD541501B8ull, 0xF7D88BC24209A565ull, 0x1F225A7CA91A4226ull,
+    0x9AE757596946075Full, 0x3375788DE9B06958ull, 0xC1A12D2FC3978937ull, 0x0052D6B1641C83AEull,
+    0xF209787BB47D6B84ull, 0xC0678C5DBD23A49Aull, 0x9745EB4D50CE6332ull, 0xF840B7BA963646E0ull,
+    0xBD176620A501FBFFull, 0xB650E5A93BC3D898ull, 0xEC5D3FA8CE427AFFull, 0xA3E51F138AB4CEBEull,
+    0x93BA47C980E98CDFull, 0xC66F336C36B10137ull, 0xB8A8D9BBE123F017ull, 0xB80B0047445D4184ull,
+    0xE6D3102AD96CEC1Dull, 0xA60DC059157491E5ull, 0x9043EA1AC7E41392ull, 0x87C89837AD68DB2Full,
+    0xB454E4A179DD1877ull, 0x29BABE4598C311FBull, 0xE16A1DC9D8545E94ull, 0xF4296DD6FEF3D67Aull,
+    0x8CE2529E2734BB1Dull, 0x1899E4A65F58660Cull, 0xB01AE745B101E9E4ull, 0x5EC05DCFF72E7F8Full,
+    0xDC21A1171D42645Dull, 0x76707543F4FA1F73ull, 0x899504AE72497EBAull, 0x6A06494A791C53A8ull,
+    0xABFA45DA0EDBDE69ull, 0x0487DB9D17636892ull, 0xD6F8D7509292D603ull, 0x45A9D2845D3C42B6ull,
+    0x865B86925B9BC5C2ull, 0x0B8A2392BA45A9B2ull, 0xA7F26836F282B732ull, 0x8E6CAC7768D7141Eull,
+    0xD1EF0244AF2364FFull, 0x3207D795430CD926ull, 0x8335616AED761F1Full, 0x7F44E6BD49E807B8ull,
+    0xA402B9C5A8D3A6E7ull, 0x5F16206C9C6209A6ull, 0xCD036837130890A1ull, 0x36DBA887C37A8C0Full,
+    0x802221226BE55A64ull, 0xC2494954DA2C9789ull, 0xA02AA96B06DEB0FDull, 0xF2DB9BAA10B7BD6Cull,
+    0xC83553C5C8965D3Dull, 0x6F92829494E5ACC7ull, 0xFA42A8B73ABBF48Cull, 0xCB772339BA1F17F9ull,
+    0x9C69A97284B578D7ull, 0xFF2A760414536EFBull, 0xC38413CF25E2D70Dull, 0xFEF5138519684ABAull,
+    0xF46518C2EF5B8CD1ull, 0x7EB258665FC25D69ull, 0x98BF2F79D5993802ull, 0xEF2F773FFBD97A61ull,
+    0xBEEEFB584AFF8603ull, 0xAAFB550FFACFD8FAull, 0xEEAABA2E5DBF6784ull, 0x95BA2A53F983CF38ull,
+    0x952AB45CFA97A0B2ull, 0xDD945A747BF26183ull, 0xBA756174393D88DFull, 0x94F971119AEEF9E4ull,
+    0xE912B9D1478CEB17ull, 0x7A37CD5601AAB85Dull, 0x91ABB422CCB812EEull, 0xAC62E055C10AB33Aull,
+    0xB616A12B7FE617AAull, 0x577B986B314D6009ull, 0xE39C49765FDF9D94ull, 0xED5A7E85FDA0B80Bull,
+    0x8E41ADE9FBEBC27Dull, 0x14588F13BE847307ull, 0xB1D219647AE6B31Cull, 0x596EB2D8AE258FC8ull,
+    0xDE469FBD99A05FE3ull, 0x6FCA5F8ED9AEF3BBull, 0x8AEC23D680043BEEull, 0x25DE7BB9480D5854ull,
+    0xADA72CCC20054AE9ull, 0xAF561AA79A10AE6Aull, 0xD910F7FF28069DA4ull, 0x1B2BA1518094DA04ull,
+    0x87AA9AFF79042286ull, 0x90FB44D2F05D0842ull, 0xA99541BF57452B28ull, 0x353A1607AC744A53ull,
+    0xD3FA922F2D1675F2ull, 0x42889B8997915CE8ull, 0x847C9B5D7C2E09B7ull, 0x69956135FEBADA11ull,
+    0xA59BC234DB398C25ull, 0x43FAB9837E699095ull, 0xCF02B2C21207EF2Eull, 0x94F967E45E03F4BBull,
+    0x8161AFB94B44F57Dull, 0x1D1BE0EEBAC278F5ull, 0xA1BA1BA79E1632DCull, 0x6462D92A69731732ull,
+    0xCA28A291859BBF93ull, 0x7D7B8F7503CFDCFEull, 0xFCB2CB35E702AF78ull, 0x5CDA735244C3D43Eull,
+    0x9DEFBF01B061ADABull, 0x3A0888136AFA64A7ull, 0xC56BAEC21C7A1916ull, 0x088AAA1845B8FDD0ull,
+    0xF6C69A72A3989F5Bull, 0x8AAD549E57273D45ull, 0x9A3C2087A63F6399ull, 0x36AC54E2F678864Bull,
+    0xC0CB28A98FCF3C7Full, 0x84576A1BB416A7DDull, 0xF0FDF2D3F3C30B9Full, 0x656D44A2A11C51D5ull,
+    0x969EB7C47859E743ull, 0x9F644AE5A4B1B325ull, 0xBC4665B596706114ull, 0x873D5D9F0DDE1FEEull,
+    0xEB57FF22FC0C7959ull, 0xA90CB506D155A7EAull, 0x9316FF75DD87CBD8ull, 0x09A7F12442D588F2ull,
+    0xB7DCBF5354E9BECEull, 0x0C11ED6D538AEB2Full, 0xE5D3EF282A242E81ull, 0x8F1668C8A86DA5FAull,
+    0x8FA475791A569D10ull, 0xF96E017D694487BCull, 0xB38D92D760EC4455ull, 0x37C981DCC395A9ACull,
+    0xE070F78D3927556Aull, 0x85BBE253F47B1417ull, 0x8C469AB843B89562ull, 0x93956D7478CCEC8Eull,
+    0xAF58416654A6BABBull, 0x387AC8D1970027B2ull, 0xDB2E51BFE9D0696Aull, 0x06997B05FCC0319Eull,
+    0x88FCF317F22241E2ull, 0x441FECE3BDF81F03ull, 0xAB3C2FDDEEAAD25Aull, 0xD527E81CAD7626C3ull,
+    0xD60B3BD56A5586F1ull, 0x8A71E223D8D3B074ull, 0x85C7056562757456ull, 0xF6872D5667844E49ull,
+    0xA738C6BEBB12D16Cull, 0xB428F8AC016561DBull, 0xD106F86E69D785C7ull, 0xE13336D701BEBA52ull,
+    0x82A45B450226B39Cull, 0xECC0024661173473ull, 0xA34D721642B06084ull, 0x27F002D7F95D0190ull,
+    0xCC20CE9BD35C78A5ull, 0x31EC038DF7B441F4ull, 0xFF290242C83396CEull, 0x7E67047175A15271ull,
+    0x9F79A169BD203E41ull, 0x0F0062C6E984D386ull, 0xC75809C42C684DD1ull, 0x52C07B78A3E60868ull,
+    0xF92E0C3537826145ull, 0xA7709A56CCDF8A82ull, 0x9BBCC7A142B17CCBull, 0x88A66076400BB691ull,
+    0xC2ABF989935DDBFEull, 0x6ACFF893D00EA435ull, 0xF356F7EBF83552FEull, 0x0583F6B8C4124D43ull,
+    0x98165AF37B2153DEull, 0xC3727A337A8B704Aull, 0xBE1BF1B059E9A8D6ull, 0x744F18C0592E4C5Cull,
+    0xEDA2EE1C7064130Cull, 0x1162DEF06F79DF73ull, 0x9485D4D1C63E8BE7ull, 0x8ADDCB5645AC2BA8ull,
+    0xB9A74A0637CE2EE1ull, 0x6D953E2BD7173692ull, 0xE8111C87C5C1BA99ull, 0xC8FA8DB6CCDD0437ull,
+    0x910AB1D4DB9914A0ull, 0x1D9C9892400A22A2ull, 0xB54D5E4A127F59C8ull, 0x2503BEB6D00CAB4Bull,
+    0xE2A0B5DC971F303Aull, 0x2E44AE64840FD61Dull, 0x8DA471A9DE737E24ull, 0x5CEAECFED289E5D2ull,
+    0xB10D8E1456105DADull, 0x7425A83E872C5F47ull, 0xDD50F1996B947518ull, 0xD12F124E28F77719ull,
+    0x8A5296FFE33CC92Full, 0x82BD6B70D99AAA6Full, 0xACE73CBFDC0BFB7Bull, 0x636CC64D1001550Bull,
+    0xD8210BEFD30EFA5Aull, 0x3C47F7E05401AA4Eull, 0x8714A775E3E95C78ull, 0x65ACFAEC34810A71ull,
+    0xA8D9D1535CE3B396ull, 0x7F1839A741A14D0Dull, 0xD31045A8341CA07Cull, 0x1EDE48111209A050ull,
+    0x83EA2B892091E44Dull, 0x934AED0AAB460432ull, 0xA4E4B66B68B65D60ull, 0xF81DA84D5617853Full,
+    0xCE1DE40642E3F4B9ull, 0x36251260AB9D668Eull, 0x80D2AE83E9CE78F3ull, 0xC1D72B7C6B426019ull,
+    0xA1075A24E4421730ull, 0xB24CF65B8612F81Full, 0xC94930AE1D529CFCull, 0xDEE033F26797B627ull,
+    0xFB9B7CD9A4A7443Cull, 0x169840EF017DA3B1ull, 0x9D412E0806E88AA5ull, 0x8E1F289560EE864Eull,
+    0xC491798A08A2AD4Eull, 0xF1A6F2BAB92A27E2ull, 0xF5B5D7EC8ACB58A2ull, 0xAE10AF696774B1DBull,
+    0x9991A6F3D6BF1765ull, 0xACCA6DA1E0A8EF29ull, 0xBFF610B0CC6EDD3Full, 0x17FD090A58D32AF3ull,
+    0xEFF394DCFF8A948Eull, 0xDDFC4B4CEF07F5B0ull, 0x95F83D0A1FB69CD9ull, 0x4ABDAF101564F98Eull,
+    0xBB764C4CA7A4440Full, 0x9D6D1AD41ABE37F1ull, 0xEA53DF5FD18D5513ull, 0x84C86189216DC5EDull,
+    0x92746B9BE2F8552Cull, 0x32FD3CF5B4E49BB4ull, 0xB7118682DBB66A77ull, 0x3FBC8C33221DC2A1ull,
+    0xE4D5E82392A40515ull, 0x0FABAF3FEAA5334Aull, 0x8F05B1163BA6832Dull, 0x29CB4D87F2A7400Eull,
+    0xB2C71D5BCA9023F8ull, 0x743E20E9EF511012ull, 0xDF78E4B2BD342CF6ull, 0x914DA9246B255416ull,
+    0x8BAB8EEFB6409C1Aull, 0x1AD089B6C2F7548Eull, 0xAE9672ABA3D0C320ull, 0xA184AC2473B529B1ull,
+    0xDA3C0F568CC4F3E8ull, 0xC9E5D72D90A2741Eull, 0x8865899617FB1871ull, 0x7E2FA67C7A658892ull,
+    0xAA7EEBFB9DF9DE8Dull, 0xDDBB901B98FEEAB7ull, 0xD51EA6FA85785631ull, 0x552A74227F3EA565ull,
+    0x8533285C936B35DEull, 0xD53A88958F87275Full, 0xA67FF273B8460356ull, 0x8A892ABAF368F137ull,
+    0xD01FEF10A657842Cull, 0x2D2B7569B0432D85ull, 0x8213F56A67F6B29Bull, 0x9C3B29620E29FC73ull,
+    0xA298F2C501F45F42ull, 0x8349F3BA91B47B8Full, 0xCB3F2F7642717713ull, 0x241C70A936219A73ull,
+    0xFE0EFB53D30DD4D7ull, 0xED238CD383AA0110ull, 0x9EC95D1463E8A506ull, 0xF4363804324A40AAull,
+    0xC67BB4597CE2CE48ull, 0xB143C6053EDCD0D5ull, 0xF81AA16FDC1B81DAull, 0xDD94B7868E94050Aull,
+    0x9B10A4E5E9913128ull, 0xCA7CF2B4191C8326ull, 0xC1D4CE1F63F57D72ull, 0xFD1C2F611F63A3F0ull,
+    0xF24A01A73CF2DCCFull, 0xBC633B39673C8CECull, 0x976E41088617CA01ull, 0xD5BE0503E085D813ull,
+    0xBD49D14AA79DBC82ull, 0x4B2D8644D8A74E18ull, 0xEC9C459D51852BA2ull, 0xDDF8E7D60ED1219Eull,
+    0x93E1AB8252F33B45ull, 0xCABB90E5C942B503ull, 0xB8DA1662E7B00A17ull, 0x3D6A751F3B936243ull,
+    0xE7109BFBA19C0C9Dull, 0x0CC512670A783AD4ull, 0x906A617D450187E2ull, 0x27FB2B80668B24C5ull,
+    0xB484F9DC9641E9DAull, 0xB1F9F660802DEDF6ull, 0xE1A63853BBD26451ull, 0x5E7873F8A0396973ull,
+    0x8D07E33455637EB2ull, 0xDB0B487B6423E1E8ull, 0xB049DC016ABC5E5Full, 0x91CE1A9A3D2CDA62ull,
+    0xDC5C5301C56B75F7ull, 0x7641A140CC7810FBull, 0x89B9B3E11B6329BAull, 0xA9E904C87FCB0A9Dull,
+    0xAC2820D9623BF429ull, 0x546345FA9FBDCD44ull, 0xD732290FBACAF133ull, 0xA97C177947AD4095ull,
+    0x867F59A9D4BED6C0ull, 0x49ED8EABCCCC485Dull, 0xA81F301449EE8C70ull, 0x5C68F256BFFF5A74ull,
+    0xD226FC195C6A2F8Cull, 0x73832EEC6FFF3111ull, 0x83585D8FD9C25DB7ull, 0xC831FD53C5FF7EABull,
+    0xA42E74F3D032F525ull, 0xBA3E7CA8B77F5E55ull, 0xCD3A1230C43FB26Full, 0x28CE1BD2E55F35EBull,
+    0x80444B5E7AA7CF85ull, 0x7980D163CF5B81B3ull, 0xA0555E361951C366ull, 0xD7E105BCC332621Full,
+    0xC86AB5C39FA63440ull, 0x8DD9472BF3FEFAA7ull, 0xFA856334878FC150ull, 0xB14F98F6F0FEB951ull,
+    0x9C935E00D4B9D8D2ull, 0x6ED1BF9A569F33D3ull, 0xC3B8358109E84F07ull, 0x0A862F80EC4700C8ull,
+    0xF4A642E14C6262C8ull, 0xCD27BB612758C0FAull, 0x98E7E9CCCFBD7DBDull, 0x8038D51CB897789Cull,
+    0xBF21E44003ACDD2Cull, 0xE0470A63E6BD56C3ull, 0xEEEA5D5004981478ull, 0x1858CCFCE06CAC74ull,
+    0x95527A5202DF0CCBull, 0x0F37801E0C43EBC8ull, 0xBAA718E68396CFFDull, 0xD30560258F54E6BAull,
+    0xE950DF20247C83FDull, 0x47C6B82EF32A2069ull, 0x91D28B7416CDD27Eull, 0x4CDC331D57FA5441ull,
+    0xB6472E511C81471Dull, 0xE0133FE4ADF8E952ull, 0xE3D8F9E563A198E5ull, 0x58180FDDD97723A6ull,
+    0x8E679C2F5E44FF8Full, 0x570F09EAA7EA7648ull, 0xB201833B35D63F73ull, 0x2CD2CC6551E513DAull,
+    0xDE81E40A034BCF4Full, 0xF8077F7EA65E58D1ull, 0x8B112E86420F6191ull, 0xFB04AFAF27FAF782ull,
+    0xADD57A27D29339F6ull, 0x79C5DB9AF1F9B563ull, 0xD94AD8B1C7380874ull, 0x18375281AE7822BCull,
+    0x87CEC76F1C830548ull, 0x8F2293910D0B15B5ull, 0xA9C2794AE3A3C69Aull, 0xB2EB3875504DDB22ull,
+    0xD433179D9C8CB841ull, 0x5FA60692A46151EBull, 0x849FEEC281D7F328ull, 0xDBC7C41BA6BCD333ull,
+    0xA5C7EA73224DEFF3ull, 0x12B9B522906C0800ull, 0xCF39E50FEAE16BEFull, 0xD768226B34870A00ull,
+    0x81842F29F2CCE375ull, 0xE6A1158300D46640ull, 0xA1E53AF46F801C53ull, 0x60495AE3C1097FD0ull,
+    0xCA5E89B18B602368ull, 0x385BB19CB14BDFC4ull, 0xFCF62C1DEE382C42ull, 0x46729E03DD9ED7B5ull,
+    0x9E19DB92B4E31BA9ull, 0x6C07A2C26A8346D1ull
+};
+
+void Multiply64(Uint64 a, Uint64 b, Uint64 *high, Uint64 *low) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    *low = _umul128(a, b, high);
+#elif defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128) a * b;
+    *high = (Uint64) (product >> 64);
+    *low = (Uint64) product;
+#else
+    Uint64 aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+    Uint64 bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+    Uint64 lowLow = aLow * bLow;
+    Uint64 middle = aHigh * bLow + (lowLow >> 32);
+    Uint64 middle2 = aLow * bHigh + (middle & 0xFFFFFFFF);
+    *high = aHigh * bHigh + (middle >> 32) + (middle2 >> 32);
+    *low = (middle2 << 32) | (lowLow & 0xFFFFFFFF);
+#endif
+}
+
+// Eisel-Lemire: multiply the normalized mantissa by the 128-bit power of ten and
+// round the top 54 bits. Fails when the truncated product is too close to a
+// halfway point to decide, or the result is subnormal or out of range.
+Bool ComputeFloat64(Uint64 mantissa, Int64 exponent, Bool negative, Float64 *value) {
+    if (mantissa == 0 || exponent < -325 || exponent > 308) {
+        return FALSE;
+    }
+
+    const Uint64 *power = &powersOfTen128[(exponent + 342) * 2];
+    Int64 binaryExponent = (((152170 + 65536) * exponent) >> 16) + 1024 + 63;
+    Int64 leadingZeros = 0;
+    for (Int64 shift = 32; shift > 0; shift >>= 1) {
+        if (mantissa >> (64 - shift) == 0) {
+            mantissa <<= shift;
+            leadingZeros += shift;
+        }
+    }
+
+    Uint64 upper, lower;
+    Multiply64(mantissa, power[0], &upper, &lower);
+    if ((upper & 0x1FF) == 0x1FF && lower + mantissa < lower) {
+        Uint64 lowHigh, lowLow;
+        Multiply64(mantissa, power[1], &lowHigh, &lowLow);
+        Uint64 middle = lower + lowHigh;
+        upper += middle < lower;
+        if (middle + 1 == 0 && (upper & 0x1FF) == 0x1FF && lowLow + mantissa < lowLow) {
+            return FALSE;
+        }
+        lower = middle;
+    }
+
+    Uint64 upperBit = upper >> 63;
+    Uint64 bits = upper >> (upperBit + 9);
+    leadingZeros += (Int64) (1 ^ upperBit);
+    if (lower == 0 && (upper & 0x1FF) == 0 && (bits & 3) == 1) {
+        return FALSE;
+    }
+
+    bits += bits & 1;
+    bits >>= 1;
+    if (bits >= (1ull << 53)) {
+        bits = 1ull << 52;
+        leadingZeros -= 1;
+    }
+    bits &= ~(1ull << 52);
+
+    Int64 biasedExponent = binaryExponent - leadingZeros;
+    if (biasedExponent < 1 || biasedExponent > 2046) {
+        return FALSE;
+    }
+
+    bits |= (Uint64) biasedExponent << 52;
+    bits |= (Uint64) negative << 63;
+    memcpy(value, &bits, sizeof(*value));
+    return TRUE;
+}
+
+// Rewrites an already validated number as "[-]digits" "e" exponent, so strtod
+// never depends on the decimal point of the current locale. 780 significant
+// digits decide the rounding of any Float64; a trailing 1 stands in for the
+// nonzero digits dropped after them.
+Bool ParseFloat64Fallback(Bytes bytes, Float64 *value) {
+    char cstr[800];
+    Uint64 length = 0;
+    const Uint8 *cursor = bytes.base;
+    const Uint8 *end = bytes.base + bytes.size;
+
+    if (*cursor == '-' || *cursor == '+') {
+        if (*cursor == '-') {
+            cstr[length++] = '-';
+        }
+        cursor += 1;
+    }
+
+    Int64 exponent = 0;
+    Uint64 digits = 0;
+    Bool fraction = FALSE;
+    Bool dropped = FALSE;
+    for (; cursor < end && *cursor != 'e' && *cursor != 'E'; ++cursor) {
+        if (*cursor == '.') {
+            fraction = TRUE;
+        } else if (digits == 0 && *cursor == '0') {
+            exponent -= fraction;
+        } else if (digits < 780) {
+            cstr[length++] = (char) *cursor;
+            digits += 1;
+            exponent -= fraction;
+        } else {
+            dropped |= *cursor != '0';
+            exponent += !fraction;
+        }
+    }
+
+    if (digits == 0) {
+        cstr[length++] = '0';
+    }
+    if (dropped) {
+        cstr[length++] = '1';
+        exponent -= 1;
+    }
+
+    if (cursor < end) {
+        cursor += 1;
+        Bool negativeExponent = *cursor == '-';
+        cursor += *cursor == '-' || *cursor == '+';
+
+        Int64 explicitExponent = 0;
+        for (; cursor < end; ++cursor) {
+            if (explicitExponent < 100000) {
+                explicitExponent = explicitExponent * 10 + (*cursor - '0');
+            }
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    snprintf(cstr + length, sizeof(cstr) - length, "e%lld", exponent);
+
+    char *parsed = NULL;
+    *value = strtod(cstr, &parsed);
+    if (*parsed != '\0') {
+        TRACE_ERROR("Could not parse a floating-point number");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+Bool ParseFloat64(Bytes bytes, Float64 *value) {
+    const Uint8 *cursor = bytes.base;
+    const Uint8 *end = bytes.base + bytes.size;
+
+    Bool negative = FALSE;
+    if (cursor < end && (*cursor == '-' || *cursor == '+')) {
+        negative = *cursor == '-';
+        cursor += 1;
+    }
+
+    // Keep up to 19 significant digits, enough to never overflow a Uint64.
+    Uint64 mantissa = 0;
+    Uint64 significantDigits = 0;
+    Int64 exponent = 0;
+    Bool truncated = FALSE;
+
+    const Uint8 *integerStart = cursor;
+    for (; cursor < end && (Uint8) (*cursor - '0') <= 9; ++cursor) {
+        Uint8 digit = (Uint8) (*cursor - '0');
+        if (significantDigits < 19) {
+            mantissa = mantissa * 10 + digit;
+            significantDigits += mantissa != 0;
+        } else {
+            exponent += 1;
+            truncated |= digit != 0;
+        }
+    }
+    Uint64 digitCount = (Uint64) (cursor - integerStart);
+
+    if (cursor < end && *cursor == '.') {
+        cursor += 1;
+        const Uint8 *fractionStart = cursor;
+        for (; cursor < end && (Uint8) (*cursor - '0') <= 9; ++cursor) {
+            Uint8 digit = (Uint8) (*cursor - '0');
+            if (significantDigits < 19) {
+                mantissa = mantissa * 10 + digit;
+                significantDigits += mantissa != 0;
+                exponent -= 1;
+            } else {
+                truncated |= digit != 0;
+            }
+        }
+        digitCount += (Uint64) (cursor - fractionStart);
+    }
+
+    if (digitCount == 0) {
+        TRACE_ERROR("Could not parse a floating-point number");
+        return FALSE;
+    }
+
+    if (cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+        cursor += 1;
+
+        Bool negativeExponent = FALSE;
+        if (cursor < end && (*cursor == '-' || *cursor == '+')) {
+            negativeExponent = *cursor == '-';
+            cursor += 1;
+        }
+
+        const Uint8 *exponentStart = cursor;
+        Int64 explicitExponent = 0;
+        for (; cursor < end && (Uint8) (*cursor - '0') <= 9; ++cursor) {
+            if (explicitExponent < 100000) {
+                explicitExponent = explicitExponent * 10 + (*cursor - '0');
+            }
+        }
+        if (cursor == exponentStart) {
+            TRACE_ERROR("Could not parse a floating-point number");
+            return FALSE;
+        }
+
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    if (cursor != end) {
+        TRACE_ERROR("Could not parse a floating-point number");
+        return FALSE;
+    }
+
+    // Clinger's fast path: both the mantissa and the power of ten are exact, so a
+    // single multiplication or division is correctly rounded.
+    if (!truncated && mantissa <= (1ull << 53)) {
+        Float64 result = (Float64) mantissa;
+        Bool exact = TRUE;
+
+        if (mantissa == 0) {
+            result = 0.0;
+        } else if (exponent >= -22 && exponent <= 22) {
+            result = exponent < 0
+                ? result / exactPowersOfTen[-exponent]
+                : result * exactPowersOfTen[exponent];
+        } else if (exponent > 22 && exponent <= 22 + 15) {
+            Uint64 shifted = mantissa;
+            for (Int64 i = 22; i < exponent && shifted <= (1ull << 53); ++i) {
+                shifted *= 10;
+            }
+            exact = shifted <= (1ull << 53);
+            result = (Float64) shifted * exactPowersOfTen[22];
+        } else {
+            exact = FALSE;
+        }
+
+        if (exact) {
+            *value = negative ? -result : result;
+            return TRUE;
+        }
+    }
+
+    // With truncated digits the value lies between mantissa and mantissa + 1, and
+    // only counts when both ends round the same way.
+    Float64 result, upper;
+    if (ComputeFloat64(mantissa, exponent, negative, &result) &&
+        (!truncated || (ComputeFloat64(mantissa + 1, exponent, negative, &upper) && upper == result))) {
+        *value = result;
+        return TRUE;
+    }
+
+    return ParseFloat64Fallback(bytes, value);
+}
+
+// Fields are separated by delimiter. A delimiter at the very end closes the last
+// field instead of starting an empty one, and a '\r' ending a field is dropped,
+// so CRLF lines split like LF ones. Any other empty field is returned as is and
+// fails to parse.
+Bool NextDelimitedField(Bytes bytes, Uint8 delimiter, Uint64 *offset, Bytes *field) {
+    if (*offset >= bytes.size) {
+        return FALSE;
+    }
+
+    Uint8 *start = bytes.base + *offset;
+    Uint8 *next = (Uint8*) memchr(start, delimiter, (size_t) (bytes.size - *offset));
+    Uint64 size = next != NULL ? (Uint64) (next - start) : bytes.size - *offset;
+    *offset += size + 1;
+
+    if (size > 0 && start[size - 1] == '\r') {
+        size -= 1;
+    }
+
+    field->size = size;
+    field->base = start;
+
+    return TRUE;
+}
+
+Bool ParseInt64s(Bytes bytes, Uint8 delimiter, Int64 *values, Uint64 capacity, Uint64 *count) {
+    Uint64 parsed = 0;
+    Uint64 offset = 0;
+    Bytes field;
+    while (NextDelimitedField(bytes, delimiter, &offset, &field)) {
+        if (parsed == capacity) {
+            TRACE_ERROR("Not enough capacity for the parsed values");
+            *count = parsed;
+            return FALSE;
+        }
+        if (!ParseInt64(field, &values[parsed])) {
+            *count = parsed;
+            return FALSE;
+        }
+
+        parsed += 1;
+    }
+
+    *count = parsed;
+
+    return TRUE;
+}
+
+Bool ParseFloat64s(Bytes bytes, Uint8 delimiter, Float64 *values, Uint64 capacity, Uint64 *count) {
+    Uint64 parsed = 0;
+    Uint64 offset = 0;
+    Bytes field;
+    while (NextDelimitedField(bytes, delimiter, &offset, &field)) {
+        if (parsed == capacity) {
+            TRACE_ERROR("Not enough capacity for the parsed values");
+            *count = parsed;
+            return FALSE;
+        }
+        if (!ParseFloat64(field, &values[parsed])) {
+            *count = parsed;
+            return FALSE;
+        }
+
+        parsed += 1;
+    }
+
+    *count = parsed;
+
+    return TRUE;
+}
+
+static const char digitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+Uint64 CountDigits(Uint64 value) {
+    Uint64 count = 1;
+    while (value >= 10000) {
+        value /= 10000;
+        count += 4;
+    }
+    if (value >= 1000) {
+        return count + 3;
+    }
+    if (value >= 100) {
+        return count + 2;
+    }
+    if (value >= 10) {
+        return count + 1;
+    }
+
+    return count;
+}
+
+// Writes exactly count digits of value ending at end, padding with zeros.
+void WriteDigits(Uint64 value, Uint64 count, Uint8 *end) {
+    Uint8 *cursor = end;
+    while (count >= 2) {
+        const char *pair = &digitPairs[(value % 100) * 2];
+        value /= 100;
+        cursor -= 2;
+        cursor[0] = (Uint8) pair[0];
+        cursor[1] = (Uint8) pair[1];
+        count -= 2;
+    }
+    if (count == 1) {
+        cursor -= 1;
+        cursor[0] = (Uint8) ('0' + value % 10);
+    }
+}
+
+Bool FormatUint64(Uint64 value, Bytes buffer, Uint64 *length) {
+    Uint64 count = CountDigits(value);
+    if (count > buffer.size) {
+        TRACE_ERROR("Not enough space to format an unsigned integer");
+        return FALSE;
+    }
+
+    WriteDigits(value, count, buffer.base + count);
+    *length = count;
+
+    return TRUE;
+}
+
+Bool FormatInt64(Int64 value, Bytes buffer, Uint64 *length) {
+    if (value >= 0) {
+        return FormatUint64((Uint64) value, buffer, length);
+    }
+
+    Uint64 magnitude = 0 - (Uint64) value;
+    Uint64 count = CountDigits(magnitude);
+    if (count + 1 > buffer.size) {
+        TRACE_ERROR("Not enough space to format a signed integer");
+        return FALSE;
+    }
+
+    buffer.base[0] = '-';
+    WriteDigits(magnitude, count, buffer.base + 1 + count);
+    *length = count + 1;
+
+    return TRUE;
+}
+
+// Returns the top 64 bits of the 192-bit product g * cp, with the lowest bit
+// set when the bits below are not negligible, so that comparisons against the
+// rounding interval stay exact.
+Uint64 RoundToOdd(Uint64 gHigh, Uint64 gLow, Uint64 cp) {
+    Uint64 xHigh, xLow, yHigh, yLow;
+    Multiply64(gLow, cp, &xHigh, &xLow);
+    Multiply64(gHigh, cp, &yHigh, &yLow);
+
+    Uint64 middle = yLow + xHigh;
+    Uint64 top = yHigh + (middle < xHigh);
+
+    return top | (middle > 1);
+}
+
+// Schubfach: the shortest digits * 10^exponent that parses back to the finite,
+// nonzero Float64 with the given IEEE fields, the closest one when several are
+// as short. Candidates are compared in integers against the rounding interval,
+// scaled by powersOfTen128 rounded up.
+void ShortestDigits(Uint64 significand, Uint64 biasedExponent, Uint64 *digits, Int64 *exponent) {
+    Uint64 c;
+    Int64 q;
+    if (biasedExponent != 0) {
+        c = significand | (1ull << 52);
+        q = (Int64) biasedExponent - 1075;
+
+        // Integers below 2^53 are exact as they are.
+        if (q <= 0 && q > -53 && (c >> -q) << -q == c) {
+            *digits = c >> -q;
+            *exponent = 0;
+            return;
+        }
+    } else {
+        c = significand;
+        q = -1074;
+    }
+
+    Bool even = (c & 1) == 0;
+    Bool closerBelow = significand == 0 && biasedExponent > 1;
+    Uint64 cbl = 4 * c - 2 + closerBelow;
+    Uint64 cb = 4 * c;
+    Uint64 cbr = 4 * c + 2;
+
+    // k is floor(log10(2^q)), or floor(log10(3/4 * 2^q)) when the gap below is
+    // half the gap above, and h in [1, 4] aligns c with the power of ten.
+    Int64 k = (q * 1262611 - (closerBelow ? 524031 : 0)) >> 22;
+    Int64 h = q + ((-k * 1741647) >> 19) + 1;
+
+    const Uint64 *power = &powersOfTen128[(-k + 342) * 2];
+    Uint64 gHigh = power[0];
+    Uint64 gLow = power[1];
+    if (-k < -27 || -k > 55) {
+        gLow += 1;
+        gHigh += gLow == 0;
+    }
+
+    Uint64 vbl = RoundToOdd(gHigh, gLow, cbl << h);
+    Uint64 vb = RoundToOdd(gHigh, gLow, cb << h);
+    Uint64 vbr = RoundToOdd(gHigh, gLow, cbr << h);
+    Uint64 lower = vbl + !even;
+    Uint64 upper = vbr - !even;
+
+    // One digit less wins if exactly one of its two candidates is in range.
+    Uint64 s = vb / 4;
+    if (s >= 10) {
+        Uint64 shorter = s / 10;
+        Bool belowInside = lower <= 40 * shorter;
+        Bool aboveInside = 40 * (shorter + 1) <= upper;
+        if (belowInside != aboveInside) {
+            *digits = aboveInside ? shorter + 1 : shorter;
+            *exponent = k + 1;
+            return;
+        }
+    }
+
+    Bool belowInside = lower <= 4 * s;
+    Bool aboveInside = 4 * (s + 1) <= upper;
+    *exponent = k;
+    if (belowInside != aboveInside) {
+        *digits = aboveInside ? s + 1 : s;
+        return;
+    }
+
+    Uint64 middle = 4 * s + 2;
+    Bool roundUp = vb > middle || (vb == middle && (s & 1) != 0);
+    *digits = roundUp ? s + 1 : s;
+}
+
+// Numbers from 1e-5 up to 1e16 are written in positional notation, others in
+// exponent notation with at least two exponent digits, like 1.5e-07.
+Bool FormatFloat64(Float64 value, Bytes buffer, Uint64 *length) {
+    Uint64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    Bool negative = (Bool) (bits >> 63);
+    Uint64 biasedExponent = (bits >> 52) & 0x7FF;
+    Uint64 significand = bits & ((1ull << 52) - 1);
+
+    if (biasedExponent == 0x7FF) {
+        const char *text = significand != 0 ? "nan" : negative ? "-inf" : "inf";
+        Uint64 size = strlen(text);
+        if (size > buffer.size) {
+            TRACE_ERROR("Not enough space to format a floating-point number");
+            return FALSE;
+        }
+
+        memcpy(buffer.base, text, (size_t) size);
+        *length = size;
+        return TRUE;
+    }
+
+    Uint64 digits = 0;
+    Int64 exponent = 0;
+    if (biasedExponent != 0 || significand != 0) {
+        ShortestDigits(significand, biasedExponent, &digits, &exponent);
+        while (digits % 10 == 0) {
+            digits /= 10;
+            exponent += 1;
+        }
+    }
+
+    Uint64 digitCount = CountDigits(digits);
+    Int64 point = (Int64) digitCount + exponent;
+    Int64 scientific = point - 1;
+    Uint64 magnitude = (Uint64) (scientific < 0 ? -scientific : scientific);
+    Uint64 exponentDigits = magnitude >= 100 ? 3 : 2;
+    Bool positional = digits == 0 || (point > -5 && point <= 16);
+
+    Uint64 size = negative + digitCount;
+    if (positional && exponent >= 0) {
+        size += (Uint64) exponent;
+    } else if (positional && point > 0) {
+        size += 1;
+    } else if (positional) {
+        size += 2 + (Uint64) -point;
+    } else {
+        size += (digitCount > 1) + 2 + exponentDigits;
+    }
+    if (size > buffer.size) {
+        TRACE_ERROR("Not enough space to format a floating-point number");
+        return FALSE;
+    }
+
+    Uint8 *cursor = buffer.base;
+    if (negative) {
+        *cursor++ = '-';
+    }
+
+    if (positional && exponent >= 0) {
+        WriteDigits(digits, digitCount, cursor + digitCount);
+        memset(cursor + digitCount, '0', (size_t) exponent);
+    } else if (positional && point > 0) {
+        WriteDigits(digits, digitCount, cursor + 1 + digitCount);
+        memmove(cursor, cursor + 1, (size_t) point);
+        cursor[point] = '.';
+    } else if (positional) {
+        cursor[0] = '0';
+        cursor[1] = '.';
+        memset(cursor + 2, '0', (size_t) -point);
+        WriteDigits(digits, digitCount, cursor + 2 - point + digitCount);
+    } else {
+        WriteDigits(digits, digitCount, cursor + 1 + digitCount);
+        cursor[0] = cursor[1];
+        if (digitCount > 1) {
+            cursor[1] = '.';
+            cursor += 1;
+        }
+        cursor += digitCount;
+
+        cursor[0] = 'e';
+        cursor[1] = scientific < 0 ? '-' : '+';
+        WriteDigits(magnitude, exponentDigits, cursor + 2 + exponentDigits);
+    }
+
+    *length = size;
+
+    return TRUE;
+}
+
+Bool FormatTimestamp(Int64 unixSeconds, Bytes buffer, Uint64 *length) {
+    Int64 days = unixSeconds / 86400;
+    Int64 secondsOfDay = unixSeconds % 86400;
+    if (secondsOfDay < 0) {
+        secondsOfDay += 86400;
+        days -= 1;
+    }
+
+    // Convert days since 1970-01-01 to a proleptic Gregorian date using 400 year eras.
+    Int64 shifted = days + 719468;
+    Int64 era = (shifted >= 0 ? shifted : shifted - 146096) / 146097;
+    Int64 dayOfEra = shifted - era * 146097;
+    Int64 yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    Int64 dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    Int64 monthIndex = (5 * dayOfYear + 2) / 153;
+    Int64 day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    Int64 month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    Int64 year = yearOfEra + era * 400 + (month <= 2);
+
+    if (year < 0 || year > 9999) {
+        TRACE_ERROR("Timestamp year is out of range");
+        return FALSE;
+    }
+    if (buffer.size < 20) {
+        TRACE_ERROR("Not enough space to format a timestamp");
+        return FALSE;
+    }
+
+    Uint8 *cursor = buffer.base;
+    WriteDigits((Uint64) year, 4, cursor + 4);
+    cursor[4] = '-';
+    WriteDigits((Uint64) month, 2, cursor + 7);
+    cursor[7] = '-';
+    WriteDigits((Uint64) day, 2, cursor + 10);
+    cursor[10] = 'T';
+    WriteDigits((Uint64) (secondsOfDay / 3600), 2, cursor + 13);
+    cursor[13] = ':';
+    WriteDigits((Uint64) (secondsOfDay / 60 % 60), 2, cursor + 16);
+    cursor[16] = ':';
+    WriteDigits((Uint64) (secondsOfDay % 60), 2, cursor + 19);
+    cursor[19] = 'Z';
+
+    *length = 20;
+
+    return TRUE;
+}
+
+Bool WriteBytes(Writer *writer, Bytes bytes) {
+    Uint8 *cursor = bytes.base;
+    Uint64 remaining = bytes.size;
+
+    // Large writes skip the buffer, since copying them in saves nothing.
+    if (remaining >= writer->capacity) {
+        if (!FlushWriter(writer)) {
+            return FALSE;
+        }
+        return WriteAll(writer, cursor, remaining);
+    }
+
+    while (remaining > 0) {
+        Uint64 space = writer->capacity - writer->used;
+        Uint64 chunk = remaining < space ? remaining : space;
+        memcpy(writer->buffer.base + writer->used, cursor, (size_t) chunk);
+        writer->used += chunk;
+        cursor += chunk;
+        remaining -= chunk;
+
+        if (writer->used == writer->capacity && !FlushWriter(writer)) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+Bool CloseWriter(Writer *writer) {
+    Bool flushed = FlushWriter(writer);
+    Bool freed = Free(writer->buffer);
+
+    return flushed && freed;
+}
+
+void EncodeDelta(Uint32 *values, Uint64 count) {
+    Uint32 previous = 0;
+    for (Uint64 i = 0; i < count; ++i) {
+        Uint32 value = values[i];
+        values[i] = value - previous;
+        previous = value;
+    }
+}
+
+void DecodeDelta(Uint32 *values, Uint64 count) {
+    Uint32 sum = 0;
+    for (Uint64 i = 0; i < count; ++i) {
+        sum += values[i];
+        values[i] = sum;
+    }
+}
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define OS_X86
+#if !defined(_MSC_VER)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+#endif
+
+void Cpuid(Uint32 leaf, Uint32 subleaf, Uint32 registers[4]) {
+#if defined(OS_X86) && defined(_MSC_VER)
+    __cpuidex((int*) registers, (int) leaf, (int) subleaf);
+#elif defined(OS_X86)
+    __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#else
+    registers[0] = registers[1] = registers[2] = registers[3] = 0;
+#endif
+}
+
+// Reads XCR0, which tells which vector registers the OS saves on context
+// switches. A CPU may support AVX while the OS does not.
+Uint64 ExtendedControlRegister() {
+#if defined(OS_X86) && defined(_MSC_VER)
+    return _xgetbv(0);
+#elif defined(OS_X86)
+    Uint32 low, high;
+    __asm__ volatile ("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return ((Uint64) high << 32) | low;
+#else
+    return 0;
+#endif
+}
+
+Uint32 CpuFeatures(void) {
+    // Detection is idempotent, so racing threads at worst repeat it. Bit 32
+    // marks the word as detected, so the flag and the features are published
+    // together by one atomic store.
+    static volatile Uint64 cached = 0;
+    Uint64 known = AtomicLoad64(&cached);
+    if (known != 0) {
+        return (Uint32) known;
+    }
+
+    Uint32 features = 0;
+    Uint32 registers[4];
+    Cpuid(0, 0, registers);
+    Uint32 maxLeaf = registers[0];
+
+    if (maxLeaf >= 1) {
+        Cpuid(1, 0, registers);
+        Uint32 ecx = registers[2];
+        Uint32 edx = registers[3];
+        features |= (edx & (1u << 26)) ? CPU_SSE2 : 0;
+        features |= (ecx & (1u << 9)) ? CPU_SSSE3 : 0;
+        features |= (ecx & (1u << 19)) ? CPU_SSE41 : 0;
+
+        Bool osxsave = (ecx & (1u << 27)) != 0;
+        Uint64 xcr0 = osxsave ? ExtendedControlRegister() : 0;
+        Bool avxState = (xcr0 & 0x6) == 0x6;
+        Bool avx512State = (xcr0 & 0xE6) == 0xE6;
+
+        if (maxLeaf >= 7) {
+            Cpuid(7, 0, registers);
+            Uint32 ebx = registers[1];
+            features |= (avxState && (ebx & (1u << 5))) ? CPU_AVX2 : 0;
+            features |= (avx512State && (ebx & (1u << 16))) ? CPU_AVX512F : 0;
+            features |= (avx512State && (ebx & (1u << 30))) ? CPU_AVX512BW : 0;
+        }
+    }
+
+    AtomicStore64(&cached, (1ull << 32) | features);
+
+    return features;
+}
+
+// Decodes whole groups of four values while at least 16 bytes of data are left,
+// returning how many values were decoded.
+Uint64 DecodeStreamVByteGroupsScalar(const Uint8 *control, const Uint8 **data, const Uint8 *end, Uint64 count, Uint32 *values) {
+    const Uint8 *cursor = *data;
+    Uint64 i = 0;
+    for (; i + 4 <= count && end - cursor >= 16; i += 4) {
+        Uint8 codes = control[i / 4];
+        for (Uint32 lane = 0; lane < 4; ++lane) {
+            Uint32 code = (codes >> (lane * 2)) & 3;
+            Uint32 value = (Uint32) cursor[0] | ((Uint32) cursor[1] << 8) | ((Uint32) cursor[2] << 16) | ((Uint32) cursor[3] << 24);
+            Uint32 mask = code == 3 ? 0xFFFFFFFF : (1u << ((code + 1) * 8)) - 1;
+            values[i + lane] = value & mask;
+            cursor += code + 1;
+        }
+    }
+
+    *data = cursor;
+
+    return i;
+}
+
+#if defined(OS_X86)
+
+// Byte shuffle that widens the four values of a control byte to 32 bits each,
+// and how many data bytes those values take.
+static const Uint8 streamVByteShuffles[256][16] = {
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x80, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80, 0x06, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x80, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80, 0x06, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x80, 0x80, 0x80, 0x07, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x80, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x80, 0x80, 0x80, 0x06, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x80, 0x80, 0x80, 0x07, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x80, 0x80, 0x80, 0x08, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x80, 0x06, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x80, 0x80, 0x07, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x08, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80, 0x80, 0x09, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x80, 0x80, 0x06, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80, 0x07, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x80, 0x80, 0x06, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80, 0x07, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x80, 0x80, 0x08, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x05, 0x80, 0x80, 0x06, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x80, 0x80, 0x07, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x80, 0x80, 0x08, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x80, 0x80, 0x09, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x80, 0x07, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x08, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80, 0x09, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80, 0x0A, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x06, 0x80, 0x07, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80, 0x08, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x06, 0x80, 0x07, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80, 0x08, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x80, 0x09, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x05, 0x06, 0x80, 0x07, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x07, 0x80, 0x08, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x08, 0x80, 0x09, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x80, 0x0A, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x08, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x09, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x0A, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80, 0x0B, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80, 0x06, 0x07, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80, 0x06, 0x07, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x80, 0x80, 0x80, 0x07, 0x08, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x80, 0x80, 0x80, 0x06, 0x07, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x80, 0x80, 0x80, 0x07, 0x08, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x80, 0x80, 0x80, 0x08, 0x09, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x80, 0x06, 0x07, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x80, 0x80, 0x07, 0x08, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x08, 0x09, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80, 0x80, 0x09, 0x0A, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80, 0x07, 0x08, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80, 0x07, 0x08, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x80, 0x80, 0x08, 0x09, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x80, 0x80, 0x07, 0x08, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x80, 0x80, 0x08, 0x09, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x80, 0x80, 0x09, 0x0A, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x80, 0x07, 0x08, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x08, 0x09, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80, 0x09, 0x0A, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80, 0x0A, 0x0B, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80, 0x08, 0x09, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80, 0x08, 0x09, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x80, 0x09, 0x0A, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x07, 0x80, 0x08, 0x09, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x08, 0x80, 0x09, 0x0A, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x80, 0x0A, 0x0B, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x08, 0x09, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x09, 0x0A, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x0A, 0x0B, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80, 0x0B, 0x0C, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x05, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x06, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80, 0x06, 0x07, 0x08, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x06, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80, 0x06, 0x07, 0x08, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x80, 0x80, 0x80, 0x07, 0x08, 0x09, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x80, 0x80, 0x80, 0x06, 0x07, 0x08, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x80, 0x80, 0x80, 0x07, 0x08, 0x09, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x80, 0x80, 0x80, 0x08, 0x09, 0x0A, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x80, 0x06, 0x07, 0x08, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x80, 0x80, 0x07, 0x08, 0x09, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x08, 0x09, 0x0A, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80, 0x80, 0x09, 0x0A, 0x0B, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x06, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80, 0x07, 0x08, 0x09, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80, 0x07, 0x08, 0x09, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x80, 0x80, 0x08, 0x09, 0x0A, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x80, 0x80, 0x07, 0x08, 0x09, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x80, 0x80, 0x08, 0x09, 0x0A, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x80, 0x80, 0x09, 0x0A, 0x0B, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x80, 0x07, 0x08, 0x09, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x08, 0x09, 0x0A, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80, 0x09, 0x0A, 0x0B, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80, 0x0A, 0x0B, 0x0C, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x07, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x08, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80, 0x08, 0x09, 0x0A, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x08, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80, 0x08, 0x09, 0x0A, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x80, 0x09, 0x0A, 0x0B, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x07, 0x80, 0x08, 0x09, 0x0A, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x08, 0x80, 0x09, 0x0A, 0x0B, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x80, 0x0A, 0x0B, 0x0C, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x08, 0x09, 0x0A, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x09, 0x0A, 0x0B, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x0A, 0x0B, 0x0C, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80, 0x0B, 0x0C, 0x0D, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x80},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x80},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x05, 0x06},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x06, 0x07},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80, 0x06, 0x07, 0x08, 0x09},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x06, 0x07},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x80, 0x80, 0x80, 0x06, 0x07, 0x08, 0x09},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x80, 0x80, 0x80, 0x07, 0x08, 0x09, 0x0A},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x80, 0x80, 0x80, 0x06, 0x07, 0x08, 0x09},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x80, 0x80, 0x80, 0x07, 0x08, 0x09, 0x0A},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x80, 0x80, 0x80, 0x08, 0x09, 0x0A, 0x0B},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x80, 0x06, 0x07, 0x08, 0x09},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x80, 0x80, 0x07, 0x08, 0x09, 0x0A},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x08, 0x09, 0x0A, 0x0B},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80, 0x80, 0x09, 0x0A, 0x0B, 0x0C},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x06, 0x07},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x09},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80, 0x07, 0x08, 0x09, 0x0A},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x09},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x80, 0x80, 0x07, 0x08, 0x09, 0x0A},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x80, 0x80, 0x08, 0x09, 0x0A, 0x0B},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x09},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x80, 0x80, 0x07, 0x08, 0x09, 0x0A},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x80, 0x80, 0x08, 0x09, 0x0A, 0x0B},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x80, 0x80, 0x09, 0x0A, 0x0B, 0x0C},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x80, 0x07, 0x08, 0x09, 0x0A},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x08, 0x09, 0x0A, 0x0B},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x80, 0x09, 0x0A, 0x0B, 0x0C},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80, 0x0A, 0x0B, 0x0C, 0x0D},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x07, 0x08},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x08, 0x09},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x0A},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80, 0x08, 0x09, 0x0A, 0x0B},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x08, 0x09},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x0A},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x07, 0x80, 0x08, 0x09, 0x0A, 0x0B},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x80, 0x09, 0x0A, 0x0B, 0x0C},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x0A},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x07, 0x80, 0x08, 0x09, 0x0A, 0x0B},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x08, 0x80, 0x09, 0x0A, 0x0B, 0x0C},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x80, 0x0A, 0x0B, 0x0C, 0x0D},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x08, 0x09, 0x0A, 0x0B},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x80, 0x09, 0x0A, 0x0B, 0x0C},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x0A, 0x0B, 0x0C, 0x0D},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x80, 0x0B, 0x0C, 0x0D, 0x0E},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x80, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x80, 0x80, 0x80, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x80, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x80, 0x80, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x80, 0x80, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x80, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x80, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x80, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x80, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E},
+    {0x00, 0x80, 0x80, 0x80, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C},
+    {0x00, 0x01, 0x80, 0x80, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D},
+    {0x00, 0x01, 0x02, 0x80, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F}
+};
+
+static const Uint8 streamVByteLengths[256] = {
+    4, 5, 6, 7, 5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10,
+    5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11,
+    6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12,
+    7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13,
+    5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11,
+    6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12,
+    7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13,
+    8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14,
+    6, 7, 8, 9, 7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12,
+    7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13,
+    8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14,
+    9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15,
+    7, 8, 9, 10, 8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13,
+    8, 9, 10, 11, 9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14,
+    9, 10, 11, 12, 10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15,
+    10, 11, 12, 13, 11, 12, 13, 14, 12, 13, 14, 15, 13, 14, 15, 16
+};
+
+#if !defined(_MSC_VER)
+__attribute__((target("ssse3")))
+#endif
+Uint64 DecodeStreamVByteGroupsSsse3(const Uint8 *control, const Uint8 **data, const Uint8 *end, Uint64 count, Uint32 *values) {
+    const Uint8 *cursor = *data;
+    Uint64 i = 0;
+    for (; i + 4 <= count && end - cursor >= 16; i += 4) {
+        Uint8 codes = control[i / 4];
+        __m128i bytes = _mm_loadu_si128((const __m128i*) cursor);
+        __m128i shuffle = _mm_loadu_si128((const __m128i*) streamVByteShuffles[codes]);
+        _mm_storeu_si128((__m128i*) (values + i), _mm_shuffle_epi8(bytes, shuffle));
+        cursor += streamVByteLengths[codes];
+    }
+
+    *data = cursor;
+
+    return i;
+}
+
+#endif
+
+// Kernels with several implementations are called through a pointer resolved on
+// first use: the resolver picks the best implementation for this CPU with
+// CpuFeatures and publishes it with a release store, and later calls load it
+// with acquire ordering and go straight to the chosen kernel. The pointer lives
+// in a Uint64 so that the header's atomics apply, with 0 meaning not resolved
+// yet; racing first calls resolve the same kernel.
+typedef Uint64 (*DecodeStreamVByteGroupsKernel)(const Uint8*, const Uint8**, const Uint8*, Uint64, Uint32*);
+
+static volatile Uint64 decodeStreamVByteGroups = 0;
+
+DecodeStreamVByteGroupsKernel ResolveDecodeStreamVByteGroups(void) {
+    Uint64 kernel = AtomicLoad64(&decodeStreamVByteGroups);
+    if (kernel == 0) {
+        DecodeStreamVByteGroupsKernel chosen = DecodeStreamVByteGroupsScalar;
+#if defined(OS_X86)
+        if (CpuFeatures() & CPU_SSSE3) {
+            chosen = DecodeStreamVByteGroupsSsse3;
+        }
+#endif
+        kernel = (Uint64) (size_t) chosen;
+        AtomicStore64(&decodeStreamVByteGroups, kernel);
+    }
+
+    return (DecodeStreamVByteGroupsKernel) (size_t) kernel;
+}
+
+// Stream VByte keeps the 2-bit lengths of four values in one control byte, with
+// all control bytes stored before the data bytes, so decoding never has to
+// branch on a continuation bit.
+Uint64 StreamVByteSize(Uint64 count) {
+    return (count + 3) / 4 + count * 4;
+}
+
+Bool EncodeStreamVByte(const Uint32 *values, Uint64 count, Bytes buffer, Uint64 *length) {
+    Uint64 controlSize = (count + 3) / 4;
+    if (buffer.size < controlSize) {
+        TRACE_ERROR("Not enough space to encode values");
+        return FALSE;
+    }
+
+    Uint8 *control = buffer.base;
+    Uint8 *data = buffer.base + controlSize;
+    Uint8 *end = buffer.base + buffer.size;
+    memset(control, 0, (size_t) controlSize);
+
+    for (Uint64 i = 0; i < count; ++i) {
+        Uint32 value = values[i];
+        Uint32 code = (value > 0xFF) + (value > 0xFFFF) + (value > 0xFFFFFF);
+        if ((Uint64) (end - data) < code + 1) {
+            TRACE_ERROR("Not enough space to encode values");
+            return FALSE;
+        }
+
+        control[i / 4] |= (Uint8) (code << ((i % 4) * 2));
+        for (Uint32 byte = 0; byte <= code; ++byte) {
+            data[byte] = (Uint8) (value >> (byte * 8));
+        }
+        data += code + 1;
+    }
+
+    *length = (Uint64) (data - buffer.base);
+
+    return TRUE;
+}
+
+Bool DecodeStreamVByte(Bytes bytes, Uint64 count, Uint32 *values) {
+    Uint64 controlSize = (count + 3) / 4;
+    if (bytes.size < controlSize) {
+        TRACE_ERROR("Not enough bytes to decode values");
+        return FALSE;
+    }
+
+    const Uint8 *control = bytes.base;
+    const Uint8 *data = bytes.base + controlSize;
+    const Uint8 *end = bytes.base + bytes.size;
+
+    Uint64 i = ResolveDecodeStreamVByteGroups()(control, &data, end, count, values);
+
+    for (; i < count; ++i) {
+        Uint32 code = (control[i / 4] >> ((i % 4) * 2)) & 3;
+        if ((Uint64) (end - data) < code + 1) {
+            TRACE_ERROR("Not enough bytes to decode values");
+            return FALSE;
+        }
+
+        Uint32 value = 0;
+        for (Uint32 byte = 0; byte <= code; ++byte) {
+            value |= (Uint32) data[byte] << (byte * 8);
+        }
+        values[i] = value;
+        data += code + 1;
+    }
+
+    return TRUE;
+}
+
+Uint32 BitWidth(const Uint32 *values, Uint64 count, Uint32 reference) {
+    Uint32 bits = 0;
+    for (Uint64 i = 0; i < count; ++i) {
+        bits |= values[i] - reference;
+    }
+
+    Uint32 width = 0;
+    while (bits != 0) {
+        width += 1;
+        bits >>= 1;
+    }
+
+    return width;
+}
+
+// Values are stored as value - reference in bitWidth bits each, as a little
+// endian bit stream: value i starts at bit i * bitWidth, counting from the low
+// bit of the first byte, and the last byte is padded with zero bits.
+Bool PackBits(const Uint32 *values, Uint64 count, Uint32 reference, Uint32 bitWidth, Bytes buffer, Uint64 *length) {
+    Uint64 size = (count * bitWidth + 7) / 8;
+    if (bitWidth > 32) {
+        TRACE_ERROR("Bit width must be at most 32");
+        return FALSE;
+    }
+    if (buffer.size < size) {
+        TRACE_ERROR("Not enough space to pack values");
+        return FALSE;
+    }
+
+    memset(buffer.base, 0, (size_t) size);
+    for (Uint64 i = 0; i < count; ++i) {
+        Uint64 delta = (Uint64) (values[i] - reference);
+        if (delta >> bitWidth != 0) {
+            TRACE_ERROR("Value does not fit in bit width");
+            return FALSE;
+        }
+
+        Uint64 bit = i * bitWidth;
+        for (Uint32 written = 0; written < bitWidth; ) {
+            Uint64 byte = (bit + written) / 8;
+            Uint32 shift = (Uint32) ((bit + written) % 8);
+            buffer.base[byte] |= (Uint8) ((delta >> written) << shift);
+            written += 8 - shift;
+        }
+    }
+
+    *length = size;
+
+    return TRUE;
+}
+
+// Decodes values with one unaligned 64-bit load each while eight bytes are left
+// to read, returning how many values were decoded. The shift into a value's
+// first byte is at most 7, so a single load covers any width up to 32.
+Uint64 UnpackBitsGroupsScalar(const Uint8 *bytes, Uint64 size, Uint64 count, Uint32 reference, Uint32 bitWidth, Uint32 *values) {
+    Uint64 mask = (1ull << bitWidth) - 1;
+    Uint64 i = 0;
+    for (; i < count; ++i) {
+        Uint64 bit = i * bitWidth;
+        Uint64 byte = bit / 8;
+        if (byte + 8 > size) {
+            break;
+        }
+
+        Uint64 chunk = LoadLittleEndian64(bytes + byte);
+        values[i] = (Uint32) ((chunk >> (bit % 8)) & mask) + reference;
+    }
+
+    return i;
+}
+
+#if defined(OS_X86)
+
+// Eight values take exactly bitWidth bytes, so every group of eight starts on a
+// byte and lays its values out the same way. Each half of a group is loaded as
+// 16 bytes, which always hold its four values; every lane shuffles in the four
+// bytes its value starts in plus the fifth one its top bits may spill into, and
+// shifts both into place.
+#if !defined(_MSC_VER)
+__attribute__((target("avx2")))
+#endif
+Uint64 UnpackBitsGroupsAvx2(const Uint8 *bytes, Uint64 size, Uint64 count, Uint32 reference, Uint32 bitWidth, Uint32 *values) {
+    Uint64 half = bitWidth / 2;
+    Uint8 firstShuffle[32];
+    Uint8 spillShuffle[32];
+    Uint32 shifts[8];
+    for (Uint32 lane = 0; lane < 8; ++lane) {
+        Uint32 bit = lane * bitWidth - (lane >= 4 ? (Uint32) half * 8 : 0);
+        Uint32 byte = bit / 8;
+        for (Uint32 k = 0; k < 4; ++k) {
+            firstShuffle[lane * 4 + k] = byte + k <= 15 ? (Uint8) (byte + k) : 0x80;
+            spillShuffle[lane * 4 + k] = k == 0 && byte + 4 <= 15 ? (Uint8) (byte + 4) : 0x80;
+        }
+        shifts[lane] = bit % 8;
+    }
+
+    __m256i first = _mm256_loadu_si256((const __m256i*) firstShuffle);
+    __m256i spill = _mm256_loadu_si256((const __m256i*) spillShuffle);
+    __m256i shift = _mm256_loadu_si256((const __m256i*) shifts);
+    __m256i spillShift = _mm256_sub_epi32(_mm256_set1_epi32(32), shift);
+    __m256i mask = _mm256_set1_epi32((int) (Uint32) ((1ull << bitWidth) - 1));
+    __m256i base = _mm256_set1_epi32((int) reference);
+
+    Uint64 i = 0;
+    for (; i + 8 <= count; i += 8) {
+        Uint64 offset = i / 8 * bitWidth;
+        if (offset + half + 16 > size) {
+            break;
+        }
+
+        __m128i low = _mm_loadu_si128((const __m128i*) (bytes + offset));
+        __m128i high = _mm_loadu_si128((const __m128i*) (bytes + offset + half));
+        __m256i group = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+        __m256i starts = _mm256_srlv_epi32(_mm256_shuffle_epi8(group, first), shift);
+        __m256i spills = _mm256_sllv_epi32(_mm256_shuffle_epi8(group, spill), spillShift);
+        __m256i deltas = _mm256_and_si256(_mm256_or_si256(starts, spills), mask);
+        _mm256_storeu_si256((__m256i*) (values + i), _mm256_add_epi32(deltas, base));
+    }
+
+    Uint64 offset = i / 8 * bitWidth;
+    return i + UnpackBitsGroupsScalar(bytes + offset, size - offset, count - i, reference, bitWidth, values + i);
+}
+
+#endif
+
+typedef Uint64 (*UnpackBitsGroupsKernel)(const Uint8*, Uint64, Uint64, Uint32, Uint32, Uint32*);
+
+static volatile Uint64 unpackBitsGroups = 0;
+
+UnpackBitsGroupsKernel ResolveUnpackBitsGroups(void) {
+    Uint64 kernel = AtomicLoad64(&unpackBitsGroups);
+    if (kernel == 0) {
+        UnpackBitsGroupsKernel chosen = UnpackBitsGroupsScalar;
+#if defined(OS_X86)
+        if (CpuFeatures() & CPU_AVX2) {
+            chosen = UnpackBitsGroupsAvx2;
+        }
+#endif
+        kernel = (Uint64) (size_t) chosen;
+        AtomicStore64(&unpackBitsGroups, kernel);
+    }
+
+    return (UnpackBitsGroupsKernel) (size_t) kernel;
+}
+
+Bool UnpackBits(Bytes bytes, Uint64 count, Uint32 reference, Uint32 bitWidth, Uint32 *values) {
+    if (bitWidth > 32) {
+        TRACE_ERROR("Bit width must be at most 32");
+        return FALSE;
+    }
+    if (bytes.size < (count * bitWidth + 7) / 8) {
+        TRACE_ERROR("Not enough bytes to unpack values");
+        return FALSE;
+    }
+
+    Uint64 mask = (1ull << bitWidth) - 1;
+    Uint64 i = ResolveUnpackBitsGroups()(bytes.base, bytes.size, count, reference, bitWidth, values);
+    for (; i < count; ++i) {
+        Uint64 bit = i * bitWidth;
+        Uint64 delta = 0;
+        for (Uint32 read = 0; read < bitWidth; ) {
+            Uint64 byte = (bit + read) / 8;
+            Uint32 shift = (Uint32) ((bit + read) % 8);
+            delta |= ((Uint64) bytes.base[byte] >> shift) << read;
+            read += 8 - shift;
+        }
+        values[i] = (Uint32) (delta & mask) + reference;
+    }
+
+    return TRUE;
+}
+
+// Returns the first index at or after start whose value is not less than target,
+// probing exponentially further ahead before binary searching the last step.
+Uint64 GallopSorted(const Uint32 *values, Uint64 count, Uint64 start, Uint32 target) {
+    Uint64 low = start;
+    Uint64 step = 1;
+    while (low + step < count && values[low + step] < target) {
+        low += step;
+        step *= 2;
+    }
+
+    Uint64 high = low + step < count ? low + step : count;
+    while (low < high) {
+        Uint64 middle = low + (high - low) / 2;
+        if (values[middle] < target) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+// Merges sets of similar size without branching on the comparison.
+Uint64 IntersectSortedMergeScalar(const Uint32 *a, Uint64 aCount, const Uint32 *b, Uint64 bCount, Uint32 *out) {
+    Uint64 count = 0;
+    Uint64 i = 0;
+    Uint64 j = 0;
+    while (i < aCount && j < bCount) {
+        Uint32 x = a[i];
+        Uint32 y = b[j];
+        out[count] = x;
+        count += x == y;
+        i += x <= y;
+        j += y <= x;
+    }
+
+    return count;
+}
+
+#if defined(OS_X86)
+
+// Byte shuffle that moves the lanes set in a 4-bit match mask to the front, and
+// how many lanes are set.
+static const Uint8 intersectShuffles[16][16] = {
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x80, 0x80, 0x80, 0x80},
+    {0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x04, 0x05, 0x06, 0x07, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80},
+    {0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80},
+    {0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80},
+    {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F}
+};
+
+static const Uint8 intersectCounts[16] = {
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+};
+
+// Compares blocks of four values against all four rotations of the other block,
+// then advances past whichever block ends lower. Matches of a block of a are
+// collected until it is left, then packed with one shuffle and stored as a whole
+// vector; at that point count <= i, so the store never reaches values of a that
+// are still to be compared when out aliases a, nor past min(aCount, bCount).
+#if !defined(_MSC_VER)
+__attribute__((target("ssse3")))
+#endif
+Uint64 IntersectSortedMergeSsse3(const Uint32 *a, Uint64 aCount, const Uint32 *b, Uint64 bCount, Uint32 *out) {
+    Uint64 count = 0;
+    Uint64 i = 0;
+    Uint64 j = 0;
+    Uint32 matched = 0;
+    while (i + 4 <= aCount && j + 4 <= bCount) {
+        __m128i x = _mm_loadu_si128((const __m128i*) (a + i));
+        __m128i y = _mm_loadu_si128((const __m128i*) (b + j));
+        __m128i equal = _mm_or_si128(
+            _mm_or_si128(
+                _mm_cmpeq_epi32(x, y),
+                _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, _MM_SHUFFLE(0, 3, 2, 1)))
+            ),
+            _mm_or_si128(
+                _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, _MM_SHUFFLE(1, 0, 3, 2))),
+                _mm_cmpeq_epi32(x, _mm_shuffle_epi32(y, _MM_SHUFFLE(2, 1, 0, 3)))
+            )
+        );
+        matched |= (Uint32) _mm_movemask_ps(_mm_castsi128_ps(equal));
+
+        Uint32 aLast = a[i + 3];
+        Uint32 bLast = b[j + 3];
+        if (aLast <= bLast) {
+            __m128i shuffle = _mm_loadu_si128((const __m128i*) intersectShuffles[matched]);
+            __m128i matches = _mm_shuffle_epi8(x, shuffle);
+            if (count + 4 <= bCount) {
+                _mm_storeu_si128((__m128i*) (out + count), matches);
+            } else {
+                Uint32 packed[4];
+                _mm_storeu_si128((__m128i*) packed, matches);
+                memcpy(out + count, packed, intersectCounts[matched] * sizeof(Uint32));
+            }
+            count += intersectCounts[matched];
+            matched = 0;
+            i += 4;
+        }
+        j += (Uint64) (bLast <= aLast) * 4;
+    }
+
+    // Matched values of the block at i all lie below b[j], where the rest of b
+    // starts, so they are written here and the merge starts after them.
+    for (Uint32 lane = 0; matched != 0 && (j == bCount || a[i] < b[j]); ++lane, ++i) {
+        if ((matched >> lane) & 1) {
+            out[count++] = a[i];
+            matched &= ~(1u << lane);
+        }
+    }
+
+    return count + IntersectSortedMergeScalar(a + i, aCount - i, b + j, bCount - j, out + count);
+}
+
+#endif
+
+typedef Uint64 (*IntersectSortedMergeKernel)(const Uint32*, Uint64, const Uint32*, Uint64, Uint32*);
+
+static volatile Uint64 intersectSortedMerge = 0;
+
+IntersectSortedMergeKernel ResolveIntersectSortedMerge(void) {
+    Uint64 kernel = AtomicLoad64(&intersectSortedMerge);
+    if (kernel == 0) {
+        IntersectSortedMergeKernel chosen = IntersectSortedMergeScalar;
+#if defined(OS_X86)
+        if (CpuFeatures() & CPU_SSSE3) {
+            chosen = IntersectSortedMergeSsse3;
+        }
+#endif
+        kernel = (Uint64) (size_t) chosen;
+        AtomicStore64(&intersectSortedMerge, kernel);
+    }
+
+    return (IntersectSortedMergeKernel) (size_t) kernel;
+}
+
+// out may alias a, which lets IntersectSortedMany narrow its result in place.
+Uint64 IntersectSorted(const Uint32 *a, Uint64 aCount, const Uint32 *b, Uint64 bCount, Uint32 *out) {
+    if (aCount > bCount * 32 || bCount > aCount * 32) {
+        const Uint32 *small = aCount < bCount ? a : b;
+        const Uint32 *large = aCount < bCount ? b : a;
+        Uint64 smallCount = aCount < bCount ? aCount : bCount;
+        Uint64 largeCount = aCount < bCount ? bCount : aCount;
+
+        Uint64 count = 0;
+        Uint64 j = 0;
+        for (Uint64 i = 0; i < smallCount && j < largeCount; ++i) {
+            Uint32 value = small[i];
+            j = GallopSorted(large, largeCount, j, value);
+            if (j < largeCount && large[j] == value) {
+                out[count++] = value;
+            }
+        }
+
+        return count;
+    }
+
+    return ResolveIntersectSortedMerge()(a, aCount, b, bCount, out);
+}
+
+Uint64 UnionSorted(const Uint32 *a, Uint64 aCount, const Uint32 *b, Uint64 bCount, Uint32 *out) {
+    Uint64 count = 0;
+    Uint64 i = 0;
+    Uint64 j = 0;
+    while (i < aCount && j < bCount) {
+        Uint32 x = a[i];
+        Uint32 y = b[j];
+        out[count++] = x <= y ? x : y;
+        i += x <= y;
+        j += y <= x;
+    }
+
+    while (i < aCount) {
+        out[count++] = a[i++];
+    }
+    while (j < bCount) {
+        out[count++] = b[j++];
+    }
+
+    return count;
+}
+
+Uint64 DifferenceSorted(const Uint32 *a, Uint64 aCount, const Uint32 *b, Uint64 bCount, Uint32 *out) {
+    Uint64 count = 0;
+    Uint64 j = 0;
+    for (Uint64 i = 0; i < aCount; ++i) {
+        Uint32 value = a[i];
+        if (bCount > aCount * 32) {
+            j = GallopSorted(b, bCount, j, value);
+        } else {
+            while (j < bCount && b[j] < value) {
+                j += 1;
+            }
+        }
+
+        if (j == bCount || b[j] != value) {
+            out[count++] = value;
+        }
+    }
+
+    return count;
+}
+
+// Starts from the smallest set so that every following step is skewed and
+// gallops, and stops as soon as the running result is empty.
+Uint64 IntersectSortedMany(const Uint32 *const *lists, const Uint64 *counts, Uint64 listCount, Uint32 *out) {
+    if (listCount == 0) {
+        return 0;
+    }
+
+    Uint64 smallest = 0;
+    for (Uint64 i = 1; i < listCount; ++i) {
+        if (counts[i] < counts[smallest]) {
+            smallest = i;
+        }
+    }
+
+    Uint64 count = counts[smallest];
+    memmove(out, lists[smallest], (size_t) (count * sizeof(Uint32)));
+    for (Uint64 i = 0; i < listCount && count > 0; ++i) {
+        if (i != smallest) {
+            count = IntersectSorted(out, count, lists[i], counts[i], out);
+        }
+    }
+
+    return count;
+}
+
+// The mapping may move, so pointers into the old fileMap must be recomputed
+// from offsets after growing. On failure fileMap is left empty.
+Bool GrowFileMap(const char *filePath, Uint64 size, Bytes *fileMap) {
+    if (size <= fileMap->size) {
+        return TRUE;
+    }
+
+#if defined(__linux__)
+    if (fileMap->size > 0 && RemapFileWritable(filePath, size, fileMap)) {
+        return TRUE;
+    }
+#endif
+
+    Bool unmapped = UnmapFile(*fileMap);
+    fileMap->base = NULL;
+    fileMap->size = 0;
+    if (!unmapped) {
+        return FALSE;
+    }
+
+    return MapFileWritable(filePath, size, fileMap);
+}
+
+// Pools carve fixed size blocks out of chunks obtained with Alloc. Each chunk
+// starts with a cache line holding the previous chunk, and freed blocks hold
+// the next free block. Block sizes are rounded up to 8 bytes, so blocks are
+// only 8-byte aligned unless blockSize is a multiple of CACHE_LINE_SIZE.
+#define POOL_CHUNK_HEADER 64
+
+Bool InitPool(Uint64 blockSize, Uint64 blocksPerChunk, Pool *pool) {
+    if (blocksPerChunk == 0) {
+        TRACE_ERROR("A pool chunk needs at least one block");
+        return FALSE;
+    }
+
+    if (blockSize < sizeof(Uint8*)) {
+        blockSize = sizeof(Uint8*);
+    }
+    blockSize = (blockSize + 7) & ~7ull;
+
+    pool->blockSize = blockSize;
+    pool->chunkSize = POOL_CHUNK_HEADER + blockSize * blocksPerChunk;
+    pool->freeList = NULL;
+    pool->next = NULL;
+    pool->end = NULL;
+    pool->chunks = NULL;
+
+    return TRUE;
+}
+
+Bool PoolAlloc(Pool *pool, Bytes *bytes) {
+    if (pool->freeList != NULL) {
+        Uint8 *block = pool->freeList;
+        memcpy(&pool->freeList, block, sizeof(Uint8*));
+        bytes->size = pool->blockSize;
+        bytes->base = block;
+        return TRUE;
+    }
+
+    if (pool->next == pool->end) {
+        Bytes chunk;
+        if (!Alloc(pool->chunkSize, &chunk)) {
+            return FALSE;
+        }
+
+        memcpy(chunk.base, &pool->chunks, sizeof(Uint8*));
+        pool->chunks = chunk.base;
+        pool->next = chunk.base + POOL_CHUNK_HEADER;
+        pool->end = chunk.base + chunk.size;
+    }
+
+    bytes->size = pool->blockSize;
+    bytes->base = pool->next;
+    pool->next += pool->blockSize;
+
+    return TRUE;
+}
+
+void PoolFree(Pool *pool, Bytes bytes) {
+    memcpy(bytes.base, &pool->freeList, sizeof(Uint8*));
+    pool->freeList = bytes.base;
+}
+
+Bool ReleasePool(Pool *pool) {
+    Bool freed = TRUE;
+    while (pool->chunks != NULL) {
+        Bytes chunk = {pool->chunks, pool->chunkSize};
+        memcpy(&pool->chunks, chunk.base, sizeof(Uint8*));
+        freed &= Free(chunk);
+    }
+
+    pool->freeList = NULL;
+    pool->next = NULL;
+    pool->end = NULL;
+
+    return freed;
+}
+
+// Arenas reserve their whole size up front with a single Alloc, which only
+// commits pages as they are touched, and never grow. Alignment is applied to
+// addresses, since Alloc only guarantees cache line alignment when it is served
+// from the static arena.
+Bool InitArena(Uint64 size, Arena *arena) {
+    if (!Alloc(size, &arena->bytes)) {
+        return FALSE;
+    }
+
+    arena->used = 0;
+
+    return TRUE;
+}
+
+Bool ArenaAlloc(Arena *arena, Uint64 size, Uint64 alignment, Bytes *bytes) {
+    Uint64 base = (Uint64) (size_t) arena->bytes.base;
+    Uint64 offset = ((base + arena->used + alignment - 1) & ~(alignment - 1)) - base;
+    if (offset > arena->bytes.size || size > arena->bytes.size - offset) {
+        TRACE_ERROR("Not enough space left in the arena");
+        return FALSE;
+    }
+
+    arena->used = offset + size;
+    bytes->size = size;
+    bytes->base = arena->bytes.base + offset;
+
+    return TRUE;
+}
+
+Bool ArenaAllocConcurrent(Arena *arena, Uint64 size, Uint64 alignment, Bytes *bytes) {
+    Uint64 base = (Uint64) (size_t) arena->bytes.base;
+    Uint64 used = AtomicLoad64(&arena->used);
+    Uint64 offset;
+    do {
+        offset = ((base + used + alignment - 1) & ~(alignment - 1)) - base;
+        if (offset > arena->bytes.size || size > arena->bytes.size - offset) {
+            TRACE_ERROR("Not enough space left in the arena");
+            return FALSE;
+        }
+    } while (!AtomicCompareExchange64(&arena->used, &used, offset + size));
+
+    bytes->size = size;
+    bytes->base = arena->bytes.base + offset;
+
+    return TRUE;
+}
+
+void ResetArena(Arena *arena) {
+    arena->used = 0;
+}
+
+Bool ReleaseArena(Arena *arena) {
+    arena->used = 0;
+
+    return Free(arena->bytes);
+}
+
+// Handles hold a slot index in their low 32 bits and the slot's generation in
+// their high 32 bits. Each slot is a pair of Uint32: the dense index of its
+// element (or the next free slot) and a generation that is bumped on removal,
+// so handles to removed elements stop matching. Generations skip zero, which
+// keeps 0 usable as a null handle. owners maps dense indices back to slots.
+#define SLOT_MAP_NO_SLOT 0xFFFFFFFFull
+
+Bool InitSlotMap(Uint64 elementSize, Uint64 capacity, SlotMap *slotMap) {
+    if (capacity >= SLOT_MAP_NO_SLOT) {
+        TRACE_ERROR("Slot map capacity must fit in 32 bits");
+        return FALSE;
+    }
+
+    elementSize = (elementSize + 7) & ~7ull;
+    Uint64 elementsSize = elementSize * capacity;
+    Uint64 slotsSize = capacity * 2 * sizeof(Uint32);
+    Uint64 ownersSize = capacity * sizeof(Uint32);
+    if (!Alloc(elementsSize + slotsSize + ownersSize, &slotMap->bytes)) {
+        return FALSE;
+    }
+
+    slotMap->elements = slotMap->bytes.base;
+    slotMap->slots = (Uint32*) (slotMap->bytes.base + elementsSize);
+    slotMap->owners = (Uint32*) (slotMap->bytes.base + elementsSize + slotsSize);
+    slotMap->elementSize = elementSize;
+    slotMap->capacity = capacity;
+    slotMap->count = 0;
+    slotMap->used = 0;
+    slotMap->freeSlot = SLOT_MAP_NO_SLOT;
+
+    return TRUE;
+}
+
+Bool SlotMapInsert(SlotMap *slotMap, Uint64 *handle, Bytes *element) {
+    Uint64 slot = slotMap->freeSlot;
+    if (slot != SLOT_MAP_NO_SLOT) {
+        slotMap->freeSlot = slotMap->slots[slot * 2];
+    } else if (slotMap->used < slotMap->capacity) {
+        slot = slotMap->used++;
+        slotMap->slots[slot * 2 + 1] = 1;
+    } else {
+        TRACE_ERROR("Not enough capacity left in the slot map");
+        return FALSE;
+    }
+
+    Uint64 index = slotMap->count++;
+    slotMap->slots[slot * 2] = (Uint32) index;
+    slotMap->owners[index] = (Uint32) slot;
+
+    element->size = slotMap->elementSize;
+    element->base = slotMap->elements + index * slotMap->elementSize;
+    memset(element->base, 0, (size_t) element->size);
+
+    *handle = ((Uint64) slotMap->slots[slot * 2 + 1] << 32) | slot;
+
+    return TRUE;
+}
+
+Bool SlotMapGet(SlotMap *slotMap, Uint64 handle, Bytes *element) {
+    Uint64 slot = handle & 0xFFFFFFFF;
+    Uint32 generation = (Uint32) (handle >> 32);
+    if (slot >= slotMap->used || slotMap->slots[slot * 2 + 1] != generation) {
+        return FALSE;
+    }
+
+    element->size = slotMap->elementSize;
+    element->base = slotMap->elements + slotMap->slots[slot * 2] * slotMap->elementSize;
+
+    return TRUE;
+}
+
+Bool SlotMapRemove(SlotMap *slotMap, Uint64 handle) {
+    Uint64 slot = handle & 0xFFFFFFFF;
+    Uint32 generation = (Uint32) (handle >> 32);
+    if (slot >= slotMap->used || slotMap->slots[slot * 2 + 1] != generation) {
+        return FALSE;
+    }
+
+    // Move the last element into the hole to keep elements dense.
+    Uint64 index = slotMap->slots[slot * 2];
+    Uint64 last = --slotMap->count;
+    if (index != last) {
+        Uint32 lastSlot = slotMap->owners[last];
+        memcpy(
+            slotMap->elements + index * slotMap->elementSize,
+            slotMap->elements + last * slotMap->elementSize,
+            (size_t) slotMap->elementSize
+        );
+        slotMap->owners[index] = lastSlot;
+        slotMap->slots[lastSlot * 2] = (Uint32) index;
+    }
+
+    generation += 1;
+    slotMap->slots[slot * 2 + 1] = generation != 0 ? generation : 1;
+    slotMap->slots[slot * 2] = (Uint32) slotMap->freeSlot;
+    slotMap->freeSlot = slot;
+
+    return TRUE;
+}
+
+Bool ReleaseSlotMap(SlotMap *slotMap) {
+    slotMap->count = 0;
+    slotMap->used = 0;
+    slotMap->freeSlot = SLOT_MAP_NO_SLOT;
+
+    return Free(slotMap->bytes);
+}
+
+// Keys and values live in open addressing tables probed linearly. A table that
+// gets half full links a table twice its size as next, and every writer that
+// then finds next moves a chunk of slots over before writing there, so the move
+// is shared by the writers. A slot is moved by freezing its value with the top
+// bit, which readers still accept and writers wait out, copying it into next
+// unless next already has the key, and marking it moved, which sends readers
+// and writers on to next. Readers only load. Tables are kept until
+// ReleaseConcurrentMap, since a reader may still be probing one that was moved
+// out of; they add up to less than the size of the current table.
+#define CONCURRENT_MAP_FROZEN (1ull << 63)
+#define CONCURRENT_MAP_ABSENT (CONCURRENT_MAP_FROZEN - 1)
+#define CONCURRENT_MAP_MOVED (~0ull)
+#define CONCURRENT_MAP_CHUNK 256
+
+// The header takes one cache line and is followed by capacity pairs of key and
+// value. Key 0 marks an empty slot.
+typedef struct {
+    Bytes bytes;
+    Uint64 capacity;
+    Uint64 count;
+    Uint64 next;
+    Uint64 cursor;
+    Uint64 moved;
+    Uint64 retired;
+} ConcurrentMapTable;
+
+STATIC_ASSERT(sizeof(ConcurrentMapTable) == CACHE_LINE_SIZE);
+
+Uint64 HashUint64(Uint64 key) {
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53ull;
+    key ^= key >> 33;
+    return key;
+}
+
+Bool AllocConcurrentMapTable(Uint64 capacity, ConcurrentMapTable **table) {
+    Bytes bytes;
+    if (!Alloc(sizeof(ConcurrentMapTable) + capacity * 2 * sizeof(Uint64), &bytes)) {
+        return FALSE;
+    }
+
+    *table = (ConcurrentMapTable*) bytes.base;
+    (*table)->bytes = bytes;
+    (*table)->capacity = capacity;
+    (*table)->count = 0;
+    (*table)->next = 0;
+    (*table)->cursor = 0;
+    (*table)->moved = 0;
+    (*table)->retired = 0;
+
+    Uint64 *slots = (Uint64*) (*table + 1);
+    for (Uint64 index = 0; index < capacity; ++index) {
+        slots[index * 2] = 0;
+        slots[index * 2 + 1] = CONCURRENT_MAP_ABSENT;
+    }
+
+    return TRUE;
+}
+
+Bool GrowConcurrentMapTable(ConcurrentMapTable *table) {
+    if (AtomicLoad64(&table->next) != 0) {
+        return TRUE;
+    }
+
+    ConcurrentMapTable *next;
+    if (!AllocConcurrentMapTable(table->capacity * 2, &next)) {
+        return FALSE;
+    }
+
+    Uint64 expected = 0;
+    if (!AtomicCompareExchange64(&table->next, &expected, (Uint64) (size_t) next)) {
+        return Free(next->bytes);
+    }
+
+    return TRUE;
+}
+
+Bool WriteConcurrentMap(ConcurrentMap *map, ConcurrentMapTable *table, Uint64 key, Uint64 value, Bool overwrite);
+
+Bool MoveConcurrentMapSlot(ConcurrentMap *map, ConcurrentMapTable *table, Uint64 index) {
+    Uint64 *slots = (Uint64*) (table + 1);
+    Uint64 value = AtomicLoad64(&slots[index * 2 + 1]);
+    while ((value & CONCURRENT_MAP_FROZEN) == 0) {
+        if (AtomicCompareExchange64(&slots[index * 2 + 1], &value, value | CONCURRENT_MAP_FROZEN)) {
+            value |= CONCURRENT_MAP_FROZEN;
+        }
+    }
+
+    if (value == CONCURRENT_MAP_MOVED) {
+        return TRUE;
+    }
+
+    ConcurrentMapTable *next = (ConcurrentMapTable*) (size_t) AtomicLoad64(&table->next);
+    Uint64 key = AtomicLoad64(&slots[index * 2]);
+    if (!WriteConcurrentMap(map, next, key, value & ~CONCURRENT_MAP_FROZEN, FALSE)) {
+        return FALSE;
+    }
+
+    AtomicCompareExchange64(&slots[index * 2 + 1], &value, CONCURRENT_MAP_MOVED);
+
+    return TRUE;
+}
+
+// Moves the next unclaimed chunk of table. Whoever moves the last chunk makes
+// next the current table, and so on for next tables that were already moved.
+Bool HelpMoveConcurrentMap(ConcurrentMap *map, ConcurrentMapTable *table) {
+    Uint64 start = AtomicAdd64(&table->cursor, CONCURRENT_MAP_CHUNK);
+    if (start >= table->capacity) {
+        return TRUE;
+    }
+
+    for (Uint64 index = start; index < start + CONCURRENT_MAP_CHUNK; ++index) {
+        if (!MoveConcurrentMapSlot(map, table, index)) {
+            return FALSE;
+        }
+    }
+
+    if (AtomicAdd64(&table->moved, CONCURRENT_MAP_CHUNK) + CONCURRENT_MAP_CHUNK != table->capacity) {
+        return TRUE;
+    }
+
+    Uint64 current = (Uint64) (size_t) table;
+    while (AtomicLoad64(&table->moved) == table->capacity) {
+        Uint64 next = AtomicLoad64(&table->next);
+        if (!AtomicCompareExchange64(&map->table, &current, next)) {
+            break;
+        }
+
+        Uint64 retired = AtomicLoad64(&map->retired);
+        do {
+            table->retired = retired;
+        } while (!AtomicCompareExchange64(&map->retired, &retired, current));
+
+        table = (ConcurrentMapTable*) (size_t) next;
+        current = next;
+    }
+
+    return TRUE;
+}
+
+Bool WriteConcurrentMap(ConcurrentMap *map, ConcurrentMapTable *table, Uint64 key, Uint64 value, Bool overwrite) {
+    for (;;) {
+        Uint64 *slots = (Uint64*) (table + 1);
+        Uint64 mask = table->capacity - 1;
+        Uint64 index = HashUint64(key) & mask;
+        Uint64 next = AtomicLoad64(&table->next);
+
+        // Once next exists, the slot of key, or the empty slot that ends its
+        // probe sequence, is moved first, so no write can land in table after
+        // this one lands in next.
+        if (next != 0) {
+            if (!HelpMoveConcurrentMap(map, table)) {
+                return FALSE;
+            }
+
+            for (Uint64 probe = 0; probe < table->capacity; ++probe, index = (index + 1) & mask) {
+                Uint64 slotKey = AtomicLoad64(&slots[index * 2]);
+                if (slotKey == key || slotKey == 0) {
+                    if (!MoveConcurrentMapSlot(map, table, index)) {
+                        return FALSE;
+                    }
+                    break;
+                }
+            }
+
+            table = (ConcurrentMapTable*) (size_t) next;
+            continue;
+        }
+
+        // A frozen slot on the way means next exists and the probe sequence may
+        // have been closed, so the write starts over through the branch above.
+        Uint64 probe = 0;
+        for (; probe < table->capacity; ++probe, index = (index + 1) & mask) {
+            Uint64 slotKey = AtomicLoad64(&slots[index * 2]);
+            if (slotKey == 0 && AtomicCompareExchange64(&slots[index * 2], &slotKey, key)) {
+                if ((AtomicAdd64(&table->count, 1) + 1) * 2 > table->capacity) {
+                    GrowConcurrentMapTable(table);
+                }
+                slotKey = key;
+            }
+
+            Uint64 current = AtomicLoad64(&slots[index * 2 + 1]);
+            if (slotKey != key) {
+                if (current & CONCURRENT_MAP_FROZEN) {
+                    break;
+                }
+                continue;
+            }
+
+            while ((current & CONCURRENT_MAP_FROZEN) == 0) {
+                if (!overwrite && current != CONCURRENT_MAP_ABSENT) {
+                    return TRUE;
+                }
+                if (AtomicCompareExchange64(&slots[index * 2 + 1], &current, value)) {
+                    return TRUE;
+                }
+            }
+            break;
+        }
+
+        if (probe == table->capacity && !GrowConcurrentMapTable(table)) {
+            return FALSE;
+        }
+    }
+}
+
+Bool InitConcurrentMap(Uint64 capacity, ConcurrentMap *map) {
+    Uint64 tableCapacity = CONCURRENT_MAP_CHUNK;
+    while (tableCapacity < capacity * 2) {
+        tableCapacity *= 2;
+    }
+
+    ConcurrentMapTable *table;
+    if (!AllocConcurrentMapTable(tableCapacity, &table)) {
+        return FALSE;
+    }
+
+    map->table = (Uint64) (size_t) table;
+    map->retired = 0;
+
+    return TRUE;
+}
+
+Bool ConcurrentMapGet(ConcurrentMap *map, Uint64 key, Uint64 *value) {
+    ConcurrentMapTable *table = (ConcurrentMapTable*) (size_t) AtomicLoad64(&map->table);
+    while (table != NULL) {
+        Uint64 *slots = (Uint64*) (table + 1);
+        Uint64 mask = table->capacity - 1;
+        Uint64 index = HashUint64(key) & mask;
+        for (Uint64 probe = 0; probe < table->capacity; ++probe, index = (index + 1) & mask) {
+            Uint64 slotKey = AtomicLoad64(&slots[index * 2]);
+            if (slotKey == 0) {
+                break;
+            }
+            if (slotKey != key) {
+                continue;
+            }
+
+            Uint64 slotValue = AtomicLoad64(&slots[index * 2 + 1]);
+            if (slotValue == CONCURRENT_MAP_ABSENT) {
+                return FALSE;
+            }
+            if (slotValue == CONCURRENT_MAP_MOVED) {
+                break;
+            }
+
+            *value = slotValue & ~CONCURRENT_MAP_FROZEN;
+            return TRUE;
+        }
+
+        table = (ConcurrentMapTable*) (size_t) AtomicLoad64(&table->next);
+    }
+
+    return FALSE;
+}
+
+Bool ConcurrentMapPut(ConcurrentMap *map, Uint64 key, Uint64 value) {
+    if (key == 0 || value >= CONCURRENT_MAP_ABSENT) {
+        TRACE_ERROR("Concurrent map keys must be nonzero and values below 2^63 - 1");
+        return FALSE;
+    }
+
+    ConcurrentMapTable *table = (ConcurrentMapTable*) (size_t) AtomicLoad64(&map->table);
+
+    return WriteConcurrentMap(map, table, key, value, TRUE);
+}
+
+Bool ReleaseConcurrentMap(ConcurrentMap *map) {
+    Bool released = TRUE;
+
+    Uint64 table = map->retired;
+    while (table != 0) {
+        ConcurrentMapTable *retired = (ConcurrentMapTable*) (size_t) table;
+        Bytes bytes = retired->bytes;
+        table = retired->retired;
+        released = Free(bytes) && released;
+    }
+
+    table = map->table;
+    while (table != 0) {
+        ConcurrentMapTable *current = (ConcurrentMapTable*) (size_t) table;
+        Bytes bytes = current->bytes;
+        table = current->next;
+        released = Free(bytes) && released;
+    }
+
+    map->table = 0;
+    map->retired = 0;
+
+    return released;
+}
+
+// Each node is linked into its first height levels, a quarter as many nodes at
+// every level up. Nodes only ever get inserted, so linking one is a single
+// compare-exchange per level, bottom up, searching on from the previous node
+// when another insert got there first. Iteration follows level 0 alone, one
+// load per step, which no insert can hold up.
+#define SKIP_LIST_MAX_HEIGHT 12
+
+// Nodes are allocated only as large as their height, with the value following
+// the last link.
+typedef struct {
+    Uint64 key;
+    Uint64 size;
+    Uint64 height;
+    Uint64 next[SKIP_LIST_MAX_HEIGHT];
+} SkipListNode;
+
+// Heights come from a hash of the key, so inserts share no random state.
+Uint64 SkipListNodeHeight(Uint64 key) {
+    Uint64 bits = HashUint64(key);
+    Uint64 height = 1;
+    while (height < SKIP_LIST_MAX_HEIGHT && (bits & 3) == 0) {
+        height += 1;
+        bits >>= 2;
+    }
+    return height;
+}
+
+// Fills before with the last node under key at each level below levels, and
+// after with the node that follows it.
+void FindSkipListSplice(SkipList *skipList, Uint64 key, Uint64 levels, SkipListNode **before, Uint64 *after) {
+    SkipListNode *node = (SkipListNode*) (size_t) skipList->head;
+    for (Uint64 level = levels; level-- > 0; ) {
+        Uint64 next = AtomicLoad64(&node->next[level]);
+        while (next != 0 && ((SkipListNode*) (size_t) next)->key < key) {
+            node = (SkipListNode*) (size_t) next;
+            next = AtomicLoad64(&node->next[level]);
+        }
+        before[level] = node;
+        after[level] = next;
+    }
+}
+
+Bool InitSkipList(Arena *arena, SkipList *skipList) {
+    Bytes bytes;
+    if (!ArenaAllocConcurrent(arena, sizeof(SkipListNode), sizeof(Uint64), &bytes)) {
+        return FALSE;
+    }
+
+    SkipListNode *head = (SkipListNode*) bytes.base;
+    head->key = 0;
+    head->size = 0;
+    head->height = SKIP_LIST_MAX_HEIGHT;
+    for (Uint64 level = 0; level < SKIP_LIST_MAX_HEIGHT; ++level) {
+        head->next[level] = 0;
+    }
+
+    skipList->arena = arena;
+    skipList->head = (Uint64) (size_t) head;
+    skipList->height = 1;
+
+    return TRUE;
+}
+
+Bool SkipListInsert(SkipList *skipList, Uint64 key, Bytes value) {
+    Uint64 height = SkipListNodeHeight(key);
+    Uint64 size = sizeof(SkipListNode) - (SKIP_LIST_MAX_HEIGHT - height) * sizeof(Uint64) + value.size;
+    Bytes bytes;
+    if (!ArenaAllocConcurrent(skipList->arena, size, sizeof(Uint64), &bytes)) {
+        return FALSE;
+    }
+
+    SkipListNode *node = (SkipListNode*) bytes.base;
+    node->key = key;
+    node->size = value.size;
+    node->height = height;
+    if (value.size > 0) {
+        memcpy(&node->next[height], value.base, (size_t) value.size);
+    }
+
+    Uint64 levels = AtomicLoad64(&skipList->height);
+    while (levels < height && !AtomicCompareExchange64(&skipList->height, &levels, height)) {}
+    levels = levels > height ? levels : height;
+
+    SkipListNode *before[SKIP_LIST_MAX_HEIGHT];
+    Uint64 after[SKIP_LIST_MAX_HEIGHT];
+    FindSkipListSplice(skipList, key, levels, before, after);
+
+    // The node goes in front of any equal keys, so the newest one is found first.
+    for (Uint64 level = 0; level < height; ++level) {
+        for (;;) {
+            AtomicStore64(&node->next[level], after[level]);
+            Uint64 expected = after[level];
+            if (AtomicCompareExchange64(&before[level]->next[level], &expected, (Uint64) (size_t) node)) {
+                break;
+            }
+
+            while (expected != 0 && ((SkipListNode*) (size_t) expected)->key < key) {
+                before[level] = (SkipListNode*) (size_t) expected;
+                expected = AtomicLoad64(&before[level]->next[level]);
+            }
+            after[level] = expected;
+        }
+    }
+
+    return TRUE;
+}
+
+Bool SkipListFind(SkipList *skipList, Uint64 key, Bytes *value) {
+    SkipListNode *before[SKIP_LIST_MAX_HEIGHT];
+    Uint64 after[SKIP_LIST_MAX_HEIGHT];
+    FindSkipListSplice(skipList, key, AtomicLoad64(&skipList->height), before, after);
+
+    SkipListNode *node = (SkipListNode*) (size_t) after[0];
+    if (node == NULL || node->key != key) {
+        return FALSE;
+    }
+
+    value->size = node->size;
+    value->base = (Uint8*) &node->next[node->height];
+
+    return TRUE;
+}
+
+void SkipListSeek(SkipList *skipList, Uint64 key, Uint64 *cursor) {
+    SkipListNode *before[SKIP_LIST_MAX_HEIGHT];
+    Uint64 after[SKIP_LIST_MAX_HEIGHT];
+    FindSkipListSplice(skipList, key, AtomicLoad64(&skipList->height), before, after);
+
+    *cursor = (Uint64) (size_t) before[0];
+}
+
+Bool SkipListNext(SkipList *skipList, Uint64 *cursor, Uint64 *key, Bytes *value) {
+    SkipListNode *node = (SkipListNode*) (size_t) (*cursor != 0 ? *cursor : skipList->head);
+    Uint64 next = AtomicLoad64(&node->next[0]);
+    if (next == 0) {
+        return FALSE;
+    }
+
+    node = (SkipListNode*) (size_t) next;
+    *cursor = next;
+    *key = node->key;
+    value->size = node->size;
+    value->base = (Uint8*) &node->next[node->height];
+
+    return TRUE;
+}
+
+// Columns are laid out back to back in a single allocation, each starting on a
+// cache line so that loops over one field stream whole lines and can use
+// aligned vector loads. bytes receives the allocation to Free afterwards.
+Bool AllocColumns(Uint64 count, const Uint64 *fieldSizes, Uint64 fieldCount, Bytes *columns, Bytes *bytes) {
+    Uint64 size = 0;
+    for (Uint64 field = 0; field < fieldCount; ++field) {
+        size += (fieldSizes[field] * count + CACHE_LINE_SIZE - 1) & ~(Uint64) (CACHE_LINE_SIZE - 1);
+    }
+
+    if (!Alloc(size, bytes)) {
+        return FALSE;
+    }
+
+    Uint64 offset = 0;
+    for (Uint64 field = 0; field < fieldCount; ++field) {
+        columns[field].size = fieldSizes[field] * count;
+        columns[field].base = bytes->base + offset;
+        offset += (columns[field].size + CACHE_LINE_SIZE - 1) & ~(Uint64) (CACHE_LINE_SIZE - 1);
+    }
+
+    return TRUE;
+}
+
+void ScatterColumns(Bytes rows, Uint64 rowSize, const Uint64 *fieldOffsets, const Uint64 *fieldSizes, Uint64 fieldCount, Bytes *columns) {
+    Uint64 count = rows.size / rowSize;
+    for (Uint64 field = 0; field < fieldCount; ++field) {
+        const Uint8 *source = rows.base + fieldOffsets[field];
+        Uint8 *destination = columns[field].base;
+        Uint64 size = fieldSizes[field];
+        for (Uint64 row = 0; row < count; ++row) {
+            memcpy(destination, source, (size_t) size);
+            source += rowSize;
+            destination += size;
+        }
+    }
+}
+
+void GatherColumns(const Bytes *columns, const Uint64 *fieldOffsets, const Uint64 *fieldSizes, Uint64 fieldCount, Uint64 rowSize, Bytes rows) {
+    Uint64 count = rows.size / rowSize;
+    for (Uint64 field = 0; field < fieldCount; ++field) {
+        const Uint8 *source = columns[field].base;
+        Uint8 *destination = rows.base + fieldOffsets[field];
+        Uint64 size = fieldSizes[field];
+        for (Uint64 row = 0; row < count; ++row) {
+            memcpy(destination, source, (size_t) size);
+            source += size;
+            destination += rowSize;
+        }
+    }
+}
+
+Bool MapFileArray(const char *filePath, Uint64 elementSize, Uint64 elementAlignment, Bytes *fileMap, Uint64 *count) {
+    if (elementAlignment == 0) {
+        TRACE_ERROR("Element alignment must be at least 1");
+        return FALSE;
+    }
+
+    Bytes bytes;
+    if (!MapFile(filePath, &bytes)) {
+        return FALSE;
+    }
+
+    if (elementSize == 0 || bytes.size % elementSize != 0) {
+        TRACE_ERROR("File size is not a multiple of the element size");
+        UnmapFile(bytes);
+        return FALSE;
+    }
+    if ((size_t) bytes.base % elementAlignment != 0) {
+        TRACE_ERROR("File map is not aligned for the element type");
+        UnmapFile(bytes);
+        return FALSE;
+    }
+
+    *fileMap = bytes;
+    *count = bytes.size / elementSize;
+
+    return TRUE;
+}
+
+// A channel is a single producer, single consumer ring of variable length
+// frames in shared memory. Positions only grow; a frame lives at its position
+// modulo the capacity, preceded by its 8-byte length and padded to 8 bytes. A
+// frame that would straddle the end is preceded by a skip marker instead, so
+// every frame is contiguous. Each side spins briefly and then sleeps, and the
+// other side only makes a wake syscall when it sees a sleeping flag set. There
+// is no timeout: if the peer dies, ChannelReserve and ChannelPeek wait forever,
+// so a reader that must notice polls with ChannelPoll instead.
+typedef struct {
+    volatile Uint64 head;
+    Uint8 headPadding[CACHE_LINE_SIZE - 8];
+    volatile Uint64 tail;
+    Uint8 tailPadding[CACHE_LINE_SIZE - 8];
+    volatile Uint32 readerSleeping;
+    Uint8 readerPadding[CACHE_LINE_SIZE - 4];
+    volatile Uint32 writerSleeping;
+    Uint8 writerPadding[CACHE_LINE_SIZE - 4];
+    Uint64 capacity;
+} ChannelHeader;
+
+#define CHANNEL_HEADER_SIZE (5 * CACHE_LINE_SIZE)
+#define CHANNEL_SKIP 0xFFFFFFFFFFFFFFFFull
+#define CHANNEL_SPINS 1000
+
+STATIC_ASSERT(sizeof(ChannelHeader) <= CHANNEL_HEADER_SIZE);
+
+Bool OpenChannel(Bytes bytes, Channel *channel) {
+    if (bytes.size <= CHANNEL_HEADER_SIZE) {
+        TRACE_ERROR("Not enough bytes for a channel");
+        return FALSE;
+    }
+
+    // The header comes from another process, so a capacity that is still zero
+    // before InitChannel ran, or that would reach past the bytes, is refused.
+    ChannelHeader *header = (ChannelHeader*) bytes.base;
+    Uint64 capacity = header->capacity;
+    if (capacity == 0 || capacity % 8 != 0 || capacity > bytes.size - CHANNEL_HEADER_SIZE) {
+        TRACE_ERROR("Bytes do not hold an initialized channel");
+        return FALSE;
+    }
+
+    channel->shared = bytes.base;
+    channel->data = bytes.base + CHANNEL_HEADER_SIZE;
+    channel->capacity = capacity;
+
+    return TRUE;
+}
+
+Bool InitChannel(Bytes bytes, Channel *channel) {
+    if (bytes.size <= CHANNEL_HEADER_SIZE) {
+        TRACE_ERROR("Not enough bytes for a channel");
+        return FALSE;
+    }
+
+    ChannelHeader *header = (ChannelHeader*) bytes.base;
+    memset(header, 0, CHANNEL_HEADER_SIZE);
+    header->capacity = (bytes.size - CHANNEL_HEADER_SIZE) & ~7ull;
+
+    return OpenChannel(bytes, channel);
+}
+
+// Waits until the Uint64 at position differs from value, sleeping on flag.
+Uint64 ChannelWaitForChange(volatile Uint64 *position, Uint64 value, volatile Uint32 *flag) {
+    for (Uint32 spin = 0; spin < CHANNEL_SPINS; ++spin) {
+        Uint64 current = AtomicLoad64(position);
+        if (current != value) {
+            return current;
+        }
+    }
+
+    for (;;) {
+        *flag = 1;
+        FullMemoryBarrier();
+
+        Uint64 current = AtomicLoad64(position);
+        if (current != value) {
+            *flag = 0;
+            return current;
+        }
+
+        WaitOnWord(flag, 1);
+        *flag = 0;
+    }
+}
+
+void ChannelPublish(volatile Uint64 *position, Uint64 value, volatile Uint32 *flag) {
+    AtomicStore64(position, value);
+    FullMemoryBarrier();
+
+    if (*flag != 0) {
+        *flag = 0;
+        WakeWord(flag);
+    }
+}
+
+Bool ChannelReserve(Channel *channel, Uint64 size, Bytes *frame) {
+    ChannelHeader *header = (ChannelHeader*) channel->shared;
+    Uint64 needed = 8 + ((size + 7) & ~7ull);
+    if (needed > channel->capacity / 2) {
+        TRACE_ERROR("Frame is too large for the channel");
+        return FALSE;
+    }
+
+    Uint64 tail = header->tail;
+    Uint64 offset = tail % channel->capacity;
+    Uint64 contiguous = channel->capacity - offset;
+    Uint64 total = contiguous < needed ? contiguous + needed : needed;
+
+    Uint64 head = AtomicLoad64(&header->head);
+    while (tail + total - head > channel->capacity) {
+        head = ChannelWaitForChange(&header->head, head, &header->writerSleeping);
+    }
+
+    if (contiguous < needed) {
+        Uint64 skip = CHANNEL_SKIP;
+        memcpy(channel->data + offset, &skip, 8);
+        ChannelPublish(&header->tail, tail + contiguous, &header->readerSleeping);
+        offset = 0;
+    }
+
+    memcpy(channel->data + offset, &size, 8);
+    frame->size = size;
+    frame->base = channel->data + offset + 8;
+
+    return TRUE;
+}
+
+void ChannelCommit(Channel *channel, Bytes frame) {
+    ChannelHeader *header = (ChannelHeader*) channel->shared;
+    Uint64 needed = 8 + ((frame.size + 7) & ~7ull);
+
+    ChannelPublish(&header->tail, header->tail + needed, &header->readerSleeping);
+}
+
+// Skip markers are consumed on the way, so a NULL frame means the ring is
+// empty. Frame lengths come from the writer and are checked against the ring.
+Bool ChannelPoll(Channel *channel, Bytes *frame) {
+    ChannelHeader *header = (ChannelHeader*) channel->shared;
+    Uint64 head = header->head;
+
+    for (;;) {
+        Uint64 tail = AtomicLoad64(&header->tail);
+        if (tail == head) {
+            frame->size = 0;
+            frame->base = NULL;
+            return TRUE;
+        }
+
+        Uint64 offset = head % channel->capacity;
+        Uint64 size;
+        memcpy(&size, channel->data + offset, 8);
+        if (size != CHANNEL_SKIP) {
+            if (size > channel->capacity - offset - 8) {
+                TRACE_ERROR("Channel frame is larger than the channel");
+                return FALSE;
+            }
+
+            frame->size = size;
+            frame->base = channel->data + offset + 8;
+            return TRUE;
+        }
+
+        head += channel->capacity - offset;
+        ChannelPublish(&header->head, head, &header->writerSleeping);
+    }
+}
+
+Bool ChannelPeek(Channel *channel, Bytes *frame) {
+    ChannelHeader *header = (ChannelHeader*) channel->shared;
+
+    for (;;) {
+        if (!ChannelPoll(channel, frame)) {
+            return FALSE;
+        }
+        if (frame->base != NULL) {
+            return TRUE;
+        }
+
+        ChannelWaitForChange(&header->tail, header->head, &header->readerSleeping);
+    }
+}
+
+void ChannelRelease(Channel *channel, Bytes frame) {
+    ChannelHeader *header = (ChannelHeader*) channel->shared;
+    Uint64 needed = 8 + ((frame.size + 7) & ~7ull);
+
+    ChannelPublish(&header->head, header->head + needed, &header->writerSleeping);
+}
+
 #endif